@@ -10,7 +10,9 @@
 
 #include <spdlog/spdlog.h>
 
+#include "cursor_store.h"
 #include "mariaDB/pool.h"
+#include "result_store.h"
 
 
 #define EXTDB_VERSION "1.032"
@@ -20,18 +22,25 @@
 class AbstractExt
 {
 public:
-	struct resultData
-	{
-		bool wait = true;
-		std::string message;
-	};
+	typedef ResultStore::resultData resultData;
 
 	std::unordered_map<std::string, MariaDBPool> mariadb_databases;
 
+	// Results, protocols stream ASYNC + SAVE results via ResultStore::stream
+	ResultStore *stored_results_ptr;
+
+	// Cursors, SQL_CUSTOM Cursor = true calls add their open cursor for 9:FETCH
+	CursorStore *cursors_ptr;
+
 	// extInfo
 	struct extInfo
 	{
+		int min_threads;
 		int max_threads;
+		int thread_grow_wait;
+		int thread_idle_timeout;
+		int priority_max_wait;
+		int cursor_idle_timeout = 300;
 		bool allow_reset = false;
 
 		bool logger_flush = true;
@@ -0,0 +1,92 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "buffer_pool.h"
+
+
+BufferPool::BufferPool() : hits(0), misses(0), recycled(0), discarded(0)
+{
+	// 4KB -> 1MB, Max Cached ~15MB
+	std::size_t size = 4096;
+	std::size_t max_free = 128;
+	for (std::size_t i = 0; i < num_of_size_classes; ++i)
+	{
+		size_classes[i].size = size;
+		size_classes[i].max_free = max_free;
+		size_classes[i].free_buffers.reserve(max_free);
+		size *= 4;
+		max_free /= 2;
+	}
+}
+
+
+BufferPool::~BufferPool(void)
+{
+}
+
+
+std::string BufferPool::acquire(std::size_t size_hint)
+// Returns empty string with capacity >= size_hint (upto largest size class)
+{
+	std::string buffer;
+	bool found = false;
+	std::size_t i = 0;
+	while ((i < (num_of_size_classes - 1)) && (size_classes[i].size < size_hint))
+	{
+		++i;
+	}
+	{
+		std::lock_guard<std::mutex> lock(size_classes[i].mutex);
+		if (!size_classes[i].free_buffers.empty())
+		{
+			buffer = std::move(size_classes[i].free_buffers.back());
+			size_classes[i].free_buffers.pop_back();
+			found = true;
+		}
+	}
+	if (found)
+	{
+		++hits;
+	} else {
+		++misses;
+		buffer.reserve(size_classes[i].size);
+	}
+	return buffer;
+}
+
+
+void BufferPool::release(std::string &buffer)
+// Buffer goes back to largest size class it can serve, too small / too large buffers are freed
+{
+	const std::size_t capacity = buffer.capacity();
+	if ((capacity < size_classes[0].size) || (capacity > (size_classes[num_of_size_classes - 1].size * 2)))
+	{
+		++discarded;
+		return;
+	}
+	std::size_t i = num_of_size_classes - 1;
+	while (size_classes[i].size > capacity)
+	{
+		--i;
+	}
+	buffer.clear();
+	{
+		std::lock_guard<std::mutex> lock(size_classes[i].mutex);
+		if (size_classes[i].free_buffers.size() < size_classes[i].max_free)
+		{
+			size_classes[i].free_buffers.push_back(std::move(buffer));
+			++recycled;
+			return;
+		}
+	}
+	++discarded;
+}
+
+
+void BufferPool::getStats(std::string &result)
+// [1,[hits,misses,recycled,discarded]]
+{
+	result = "[1,[" + std::to_string(hits.load()) + "," + std::to_string(misses.load()) + "," + std::to_string(recycled.load()) + "," + std::to_string(discarded.load()) + "]]";
+}
@@ -0,0 +1,42 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+class BufferPool
+// Size-Classed Pool of Result Strings
+//   Workers acquire a buffer, ownership passes to ResultStore, ResultStore releases it back once result is sent
+{
+public:
+	BufferPool();
+	~BufferPool();
+
+	std::string acquire(std::size_t size_hint);
+	void release(std::string &buffer);
+	void getStats(std::string &result);
+
+private:
+	static const std::size_t num_of_size_classes = 5;
+
+	struct size_class_struct
+	{
+		std::size_t size;
+		std::size_t max_free;
+		std::mutex mutex;
+		std::vector<std::string> free_buffers;
+	};
+	size_class_struct size_classes[num_of_size_classes];
+
+	std::atomic<unsigned long> hits;
+	std::atomic<unsigned long> misses;
+	std::atomic<unsigned long> recycled;
+	std::atomic<unsigned long> discarded;
+};
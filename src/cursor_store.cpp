@@ -0,0 +1,133 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "cursor_store.h"
+
+
+CursorStore::CursorStore() : cursor_id_counter(1)
+{
+}
+
+
+CursorStore::~CursorStore(void)
+{
+}
+
+
+unsigned long CursorStore::add(std::unique_ptr<MariaDBCursor> cursor)
+{
+	std::lock_guard<std::mutex> lock(mutex_cursors);
+	const unsigned long cursor_id = cursor_id_counter++;
+	cursors[cursor_id] = std::move(cursor);
+	return cursor_id;
+}
+
+
+void CursorStore::fetch(const unsigned long &cursor_id, const std::size_t max_rows, const int &output_size, std::string &result)
+// Result [1,[<Rows>],1] more rows left, [1,[<Rows>],0] finished + Cursor is closed
+//   Cursor is closed + exception rethrown if fetching fails
+{
+	std::unique_ptr<MariaDBCursor> cursor;
+	{
+		std::lock_guard<std::mutex> lock(mutex_cursors);
+		auto cursor_itr = cursors.find(cursor_id);
+		if (cursor_itr == cursors.end())
+		{
+			result = "[0,\"Error Cursor Not Found\"]";
+			return;
+		}
+		if (!cursor_itr->second)
+		{
+			result = "[0,\"Error Cursor Busy\"]";
+			return;
+		}
+		cursor = std::move(cursor_itr->second);
+	}
+
+	// Room for [1,[ + ],1] + null terminator
+	const std::size_t max_size = (output_size > 9) ? (output_size - 9) : 0;
+	bool more_rows;
+	result = "[1,[";
+	try
+	{
+		more_rows = cursor->fetch(max_rows, max_size, result);
+	}
+	catch (...)
+	{
+		checkIn(cursor_id, cursor, false);
+		throw;
+	}
+	result += (more_rows ? "],1]" : "],0]");
+	checkIn(cursor_id, cursor, more_rows);
+}
+
+
+void CursorStore::checkIn(const unsigned long &cursor_id, std::unique_ptr<MariaDBCursor> &cursor, const bool keep_open)
+// Puts a fetched Cursor back, unless it is finished or was closed / cleared while busy
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_cursors);
+		auto cursor_itr = cursors.find(cursor_id);
+		if (cursor_itr != cursors.end())
+		{
+			if (keep_open)
+			{
+				cursor_itr->second = std::move(cursor);
+				return;
+			}
+			cursors.erase(cursor_itr);
+		}
+	}
+	cursor.reset(); // Closed after lock is released
+}
+
+
+bool CursorStore::close(const unsigned long &cursor_id)
+// Busy Cursors are closed once their fetch returns
+{
+	std::unique_ptr<MariaDBCursor> cursor;
+	{
+		std::lock_guard<std::mutex> lock(mutex_cursors);
+		auto cursor_itr = cursors.find(cursor_id);
+		if (cursor_itr == cursors.end())
+		{
+			return false;
+		}
+		cursor = std::move(cursor_itr->second);
+		cursors.erase(cursor_itr);
+	}
+	return true;
+}
+
+
+void CursorStore::idleCleanup(const int idle_timeout)
+// Closes Cursors not fetched from for idle_timeout seconds
+{
+	auto tick = boost::posix_time::second_clock::local_time();
+	std::vector<std::unique_ptr<MariaDBCursor>> expired_cursors;
+	{
+		std::lock_guard<std::mutex> lock(mutex_cursors);
+		for (auto cursor_itr = cursors.begin(); cursor_itr != cursors.end();)
+		{
+			if ((cursor_itr->second) && ((tick - cursor_itr->second->last_used).total_seconds() > idle_timeout))
+			{
+				expired_cursors.push_back(std::move(cursor_itr->second));
+				cursor_itr = cursors.erase(cursor_itr);
+			}	else {
+				++cursor_itr;
+			}
+		}
+	}
+}
+
+
+void CursorStore::clear()
+{
+	std::unordered_map<unsigned long, std::unique_ptr<MariaDBCursor>> closed_cursors;
+	{
+		std::lock_guard<std::mutex> lock(mutex_cursors);
+		closed_cursors.swap(cursors);
+	}
+}
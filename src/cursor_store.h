@@ -0,0 +1,38 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mariaDB/cursor.h"
+
+
+class CursorStore
+// Open Cursors by Cursor ID, for 9:FETCH:<Cursor ID>:<Rows> + 9:CLOSE:<Cursor ID>
+//   Each open Cursor holds a database connection, idleCleanup closes Cursors SQF forgot about
+//   Fetching checks the Cursor out of the map (nullptr entry == busy), mutex_cursors is never held over a network fetch
+{
+public:
+	CursorStore();
+	~CursorStore();
+
+	unsigned long add(std::unique_ptr<MariaDBCursor> cursor);
+	void fetch(const unsigned long &cursor_id, const std::size_t max_rows, const int &output_size, std::string &result);
+	bool close(const unsigned long &cursor_id);
+	void idleCleanup(const int idle_timeout);
+	void clear();
+
+private:
+	void checkIn(const unsigned long &cursor_id, std::unique_ptr<MariaDBCursor> &cursor, const bool keep_open);
+
+	std::unordered_map<unsigned long, std::unique_ptr<MariaDBCursor>> cursors;
+	unsigned long cursor_id_counter;
+	std::mutex mutex_cursors;
+};
@@ -26,6 +26,7 @@
 #include "abstract_ext.h"
 #include "mariaDB/exceptions.h"
 #include "md5/md5.h"
+#include "sqfparser.h"
 
 #include "protocols/abstract_protocol.h"
 #include "protocols/sql.h"
@@ -33,8 +34,10 @@
 #include "protocols/log.h"
 
 
-Ext::Ext(std::string shared_library_path)
+Ext::Ext(std::string shared_library_path) : worker_pool(io_service), mariadb_maintenance_strand(io_service), stored_results(16, &buffer_pool)
 {
+	stored_results_ptr = &stored_results;
+	cursors_ptr = &cursors;
 	uptime_start = std::chrono::steady_clock::now();
 	std::setlocale(LC_ALL, "");
 	std::locale::global(std::locale(""));
@@ -105,7 +108,7 @@ Ext::Ext(std::string shared_library_path)
 			auto console_temp = spdlog::stdout_logger_mt("extDB3 Console logger");
 			console.swap(console_temp);
 		#elif TEST_APP
-			spdlog::drop("extDB3 Console logger");{
+			spdlog::drop("extDB3 Console logger");
 			auto console_temp = spdlog::stdout_logger_mt("extDB3 Console logger");
 			console.swap(console_temp);
 		#endif
@@ -161,6 +164,10 @@ Ext::Ext(std::string shared_library_path)
 			console->info("This is used for poor man stress testing");
 			console->info("");
 			console->info("Type 'test' for spam test");
+			console->info("Type 'bench results' for result store save/poll benchmark");
+			console->info("Type 'bench statement <database_id>' for prepared statement execute benchmark");
+			console->info("Type 'bench datetime' for DATETIME to SQF Time Array conversion benchmark");
+			console->info("Type 'bench connection <database_id>' for connection option round trip + throughput benchmark");
 			console->info("Type 'quit' to exit");
 		#else
 			logger->info("Message: All development for extDB3 is done on a Linux Dedicated Server");
@@ -201,58 +208,54 @@ Ext::Ext(std::string shared_library_path)
 			ext_info.allow_reset = ptree.get("Main.Allow Reset",false);
 
 			// Start Threads + ASIO
-			ext_info.max_threads = ptree.get("Main.Threads",0);
+			ext_info.min_threads = ptree.get("Main.Threads",0);
 			int detected_cpu_cores = boost::thread::hardware_concurrency();
-			if (ext_info.max_threads <= 0)
+			if (ext_info.min_threads <= 0)
 			{
 				// Auto-Detect
 				if (detected_cpu_cores > 6)
 				{
-					#ifdef DEBUG_TESTING
-						console->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, 6);
-					#endif
-					logger->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, 6);
-					ext_info.max_threads = 6;
+					ext_info.min_threads = 6;
 				}
 				else if (detected_cpu_cores <= 2)
 				{
-					#ifdef DEBUG_TESTING
-						console->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, 2);
-					#endif
-					logger->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, 2);
-					ext_info.max_threads = 2;
+					ext_info.min_threads = 2;
 				}	else {
-					ext_info.max_threads = detected_cpu_cores;
-					#ifdef DEBUG_TESTING
-						console->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, ext_info.max_threads);
-					#endif
-					logger->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, ext_info.max_threads);
+					ext_info.min_threads = detected_cpu_cores;
 				}
-			}
-			else if (ext_info.max_threads > 8)  // Sanity Check
-			{
-				// Manual Config
 				#ifdef DEBUG_TESTING
-					console->info("extDB3: Sanity Check, Setting up {0} Worker Threads (config settings {1})", 8, ext_info.max_threads);
+					console->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, ext_info.min_threads);
 				#endif
-				logger->info("extDB3: Sanity Check, Setting up {0} Worker Threads (config settings {1})", 8, ext_info.max_threads);
-				ext_info.max_threads = 8;
+				logger->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads", detected_cpu_cores, ext_info.min_threads);
 			}	else {
 				// Manual Config
 				#ifdef DEBUG_TESTING
-					console->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads (config settings)", detected_cpu_cores, ext_info.max_threads);
+					console->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads (config settings)", detected_cpu_cores, ext_info.min_threads);
 				#endif
-				logger->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads (config settings)", detected_cpu_cores, ext_info.max_threads);
+				logger->info("extDB3: Detected {0} Cores, Setting up {1} Worker Threads (config settings)", detected_cpu_cores, ext_info.min_threads);
 			}
 
-			// Setup ASIO Worker Pool
-			io_work_ptr.reset(new boost::asio::io_service::work(io_service));
-			for (int i = 0; i < ext_info.max_threads; ++i)
+			// Dynamic Worker Threads, Max Threads defaults to Threads (Fixed Size)
+			ext_info.max_threads = ptree.get("Main.Max Threads", ext_info.min_threads);
+			if (ext_info.max_threads < ext_info.min_threads)
 			{
-				logger->info("extDB3: ...");
-				threads.create_thread(boost::bind(&boost::asio::io_service::run, &io_service));
+				ext_info.max_threads = ext_info.min_threads;
+			}
+			ext_info.thread_grow_wait = ptree.get("Main.Thread Grow Wait", 100); // Milliseconds
+			ext_info.thread_idle_timeout = ptree.get("Main.Thread Idle Timeout", 60); // Seconds
+			ext_info.priority_max_wait = ptree.get("Main.Priority Max Wait", 500); // Milliseconds, before LOW / NORMAL work is served ahead of HIGH
+			ext_info.cursor_idle_timeout = ptree.get("Main.Cursor Idle Timeout", 300); // Seconds, checked every idleCleanup
+			if (ext_info.max_threads > ext_info.min_threads)
+			{
+				#ifdef DEBUG_TESTING
+					console->info("extDB3: Worker Threads can grow upto {0}, Grow Wait: {1}ms, Idle Timeout: {2}s", ext_info.max_threads, ext_info.thread_grow_wait, ext_info.thread_idle_timeout);
+				#endif
+				logger->info("extDB3: Worker Threads can grow upto {0}, Grow Wait: {1}ms, Idle Timeout: {2}s", ext_info.max_threads, ext_info.thread_grow_wait, ext_info.thread_idle_timeout);
 			}
 
+			// Setup ASIO Worker Pool
+			worker_pool.start(ext_info.min_threads, ext_info.max_threads, ext_info.thread_grow_wait, ext_info.thread_idle_timeout, ext_info.priority_max_wait);
+
 			logger->info("");
 			logger->info("");
 
@@ -288,6 +291,7 @@ Ext::~Ext(void)
 	#endif
 	logger->info("extDB3: Closing ...");
 	stop();
+	cursors.clear();
 	mysql_library_end();
 	spdlog::drop_all();
 }
@@ -298,20 +302,18 @@ void Ext::reset()
 	stop();
 	std::lock_guard<std::mutex> lock(mutex_vec_protocols);
 	{
+		protocols_index.clear();
 		vec_protocols.clear();
 	}
+	cursors.clear(); // Cursors hold sessions from mariadb_databases
 	mariadb_databases.clear();
 
 	// Setup ASIO Worker Pool
 	io_service.reset();
-	io_work_ptr.reset(new boost::asio::io_service::work(io_service));
-	for (int i = 0; i < ext_info.max_threads; ++i)
-	{
-		threads.create_thread(boost::bind(&boost::asio::io_service::run, &io_service));
-	}
+	worker_pool.start(ext_info.min_threads, ext_info.max_threads, ext_info.thread_grow_wait, ext_info.thread_idle_timeout, ext_info.priority_max_wait);
 	mariadb_idle_cleanup_timer.reset(new boost::asio::deadline_timer(io_service));
 	mariadb_idle_cleanup_timer->expires_at(mariadb_idle_cleanup_timer->expires_at() + boost::posix_time::seconds(600));
-	mariadb_idle_cleanup_timer->async_wait(boost::bind(&Ext::idleCleanup, this, _1));
+	mariadb_idle_cleanup_timer->async_wait(mariadb_maintenance_strand.wrap(boost::bind(&Ext::idleCleanup, this, _1)));
 }
 
 
@@ -325,8 +327,7 @@ void Ext::stop()
 			mariadb_idle_cleanup_timer.reset(nullptr);
 		}
 	}
-	io_work_ptr.reset(nullptr);
-	threads.join_all();
+	worker_pool.stop();
 	io_service.stop();
 }
 
@@ -335,14 +336,16 @@ void Ext::idleCleanup(const boost::system::error_code& ec)
 {
 	if (!ec)
 	{
+		cursors.idleCleanup(ext_info.cursor_idle_timeout);
 		for(auto &dbpool : mariadb_databases)
 		{
 				dbpool.second.idleCleanup();
+				dbpool.second.healthCheck();
 		}
 		std::lock_guard<std::mutex> lock(mutex_mariadb_idle_cleanup_timer);
 		{
 			mariadb_idle_cleanup_timer->expires_at(mariadb_idle_cleanup_timer->expires_at() + boost::posix_time::seconds(300));
-			mariadb_idle_cleanup_timer->async_wait(boost::bind(&Ext::idleCleanup, this, _1));
+			mariadb_idle_cleanup_timer->async_wait(mariadb_maintenance_strand.wrap(boost::bind(&Ext::idleCleanup, this, _1)));
 		}
 	}
 }
@@ -368,6 +371,39 @@ void Ext::search(boost::filesystem::path &config_path, bool &conf_found, bool &c
 }
 
 
+void Ext::initDatabase(MariaDBPool &database_pool, const std::string &database_conf)
+// Database Config Section -> MariaDBPool, throws ptree_bad_path for missing login keys + MariaDBConnectorException
+{
+	std::string ip = ptree.get<std::string>(database_conf + ".IP");
+	unsigned int port = ptree.get<unsigned int>(database_conf + ".Port");
+	std::string username = ptree.get<std::string>(database_conf + ".Username");
+	std::string password = ptree.get<std::string>(database_conf + ".Password");
+	std::string database = ptree.get<std::string>(database_conf + ".Database");
+
+	MariaDBPool::options_struct options;
+	options.connector.multi_statements = ptree.get(database_conf + ".Multi Statements", false); // Required for SQL_CUSTOM Pipeline
+	options.connector.compress = ptree.get(database_conf + ".Compress", false);
+	options.connector.connect_timeout = ptree.get(database_conf + ".Connect Timeout", 0); // Seconds, 0 == MariaDB Connector Default
+	options.connector.read_timeout = ptree.get(database_conf + ".Read Timeout", 0);
+	options.connector.write_timeout = ptree.get(database_conf + ".Write Timeout", 0);
+	options.connector.socket = ptree.get(database_conf + ".Socket", ""); // Unix Socket / Windows Named Pipe, IP + Port are then ignored
+	options.connector.tls = ptree.get(database_conf + ".TLS", false);
+	options.connector.tls_verify_server = ptree.get(database_conf + ".TLS Verify Server", false);
+	options.connector.tls_ca = ptree.get(database_conf + ".TLS CA", "");
+	options.connector.tls_cert = ptree.get(database_conf + ".TLS Cert", "");
+	options.connector.tls_key = ptree.get(database_conf + ".TLS Key", "");
+	options.sql_statement_cache = ptree.get(database_conf + ".SQL Statement Cache", 32); // SQL Protocol BINARY mode, Prepared Queries per connection
+	options.statement_cache = ptree.get(database_conf + ".Statement Cache", 64); // SQL_CUSTOM Prepared Calls per connection, keep below max_prepared_stmt_count / connections
+	options.min_connections = ptree.get(database_conf + ".Min Connections", 1); // Opened in parallel at ADD_DATABASE
+	options.max_connections = ptree.get(database_conf + ".Max Connections", 0); // 0 == Unlimited
+	options.min_idle = ptree.get(database_conf + ".Min Idle", 0); // Idle connections kept open by idleCleanup
+	options.wait_timeout = ptree.get(database_conf + ".Max Connections Wait", 5000); // Milliseconds, before a call fails once Max Connections are in use
+	options.health_check_interval = ptree.get(database_conf + ".Health Check Interval", 300); // Seconds idle before a connection is pinged, 0 == Disabled
+
+	database_pool.init(ip, port, username, password, database, options);
+}
+
+
 void Ext::connectDatabase(char *output, const std::string &database_conf, const std::string &database_id)
 // Connection to Database, database_id used when connecting to multiple different database.
 {
@@ -381,20 +417,39 @@ void Ext::connectDatabase(char *output, const std::string &database_conf, const
 	} else {
 		try
 		{
-			std::string ip = ptree.get<std::string>(database_conf + ".IP");
-			unsigned int port = ptree.get<unsigned int>(database_conf + ".Port");
-			std::string username = ptree.get<std::string>(database_conf + ".Username");
-			std::string password = ptree.get<std::string>(database_conf + ".Password");
-			std::string database = ptree.get<std::string>(database_conf + ".Database");
-
 			MariaDBPool *database_pool = &mariadb_databases[database_id];
-			database_pool->init(ip, port, username, password, database);
+			initDatabase(*database_pool, database_conf);
+
+			// Read Replicas, comma separated Database Config Sections used by SQL_CUSTOM Read Only Calls
+			std::string replicas_str = ptree.get(database_conf + ".Replicas", "");
+			std::vector<std::string> replicas;
+			boost::split(replicas, replicas_str, boost::is_any_of(","), boost::token_compress_on);
+			for (auto &replica_conf : replicas)
+			{
+				boost::trim(replica_conf);
+				if (replica_conf.empty()) continue;
+				std::unique_ptr<MariaDBPool> replica_pool(new MariaDBPool());
+				try
+				{
+					initDatabase(*replica_pool, replica_conf);
+				}
+				catch (MariaDBConnectorException &e)
+				{
+					// Replica down at startup, Read Only Calls use the primary until it comes back
+					replica_pool->replicaFailed();
+					#ifdef DEBUG_TESTING
+						console->warn("extDB3: Replica MariaDBConnectorException: {0}: {1}", replica_conf, e.what());
+					#endif
+					logger->warn("extDB3: Replica MariaDBConnectorException: {0}: {1}", replica_conf, e.what());
+				}
+				database_pool->addReplica(std::move(replica_pool));
+			}
 
 			if (!mariadb_idle_cleanup_timer)
 			{
 				mariadb_idle_cleanup_timer.reset(new boost::asio::deadline_timer(io_service));
 				mariadb_idle_cleanup_timer->expires_at(mariadb_idle_cleanup_timer->expires_at() + boost::posix_time::seconds(600));
-				mariadb_idle_cleanup_timer->async_wait(boost::bind(&Ext::idleCleanup, this, _1));
+				mariadb_idle_cleanup_timer->async_wait(mariadb_maintenance_strand.wrap(boost::bind(&Ext::idleCleanup, this, _1)));
 			}
 			std::strcpy(output, "[1]");
 		}
@@ -420,11 +475,23 @@ void Ext::connectDatabase(char *output, const std::string &database_conf, const
 }
 
 
-void Ext::addProtocol(char *output, const std::string &database_id, const std::string &protocol, const std::string &protocol_name, const std::string &init_data)
+void Ext::addProtocol(char *output, const std::string &database_id, const std::string &protocol, const std::string &protocol_name, const std::string &init_data, const std::string &priority)
+// Protocol Name is interned here once, callExtension lookups afterwards are hashed views or #handle
+//   Priority (HIGH / NORMAL / LOW) is the worker queue used for 1: + 2: calls to this protocol
 {
 	std::lock_guard<std::mutex> lock(mutex_vec_protocols);
-	auto foo = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-	if (foo  != vec_protocols.end())
+	WorkerPool::priority_class priority_class;
+	if ((protocol_name.empty()) || (protocol_name[0] == '#'))
+	{
+		std::strcpy(output, "[0,\"Error Invalid Protocol Name\"]");
+		logger->warn("extDB3: Error Invalid Protocol Name: {0}", protocol_name);
+	}
+	else if (!WorkerPool::getPriorityClass(priority, priority_class))
+	{
+		std::strcpy(output, "[0,\"Error Invalid Priority\"]");
+		logger->warn("extDB3: Error Invalid Priority: {0}", priority);
+	}
+	else if (protocols_index.count(boost::string_view(protocol_name)) > 0)
 	{
 		std::strcpy(output, "[0,\"Error Protocol Name Already Taken\"]");
 		logger->warn("extDB3: Error Protocol Name Already Taken: {0}", protocol_name);
@@ -432,13 +499,14 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 	else
 	{
 		bool status = true;
-		protocol_struct protocol_data;
-		protocol_data.name = protocol_name;
+		std::unique_ptr<protocol_struct> protocol_data(new protocol_struct());
+		protocol_data->name = protocol_name;
+		protocol_data->priority = priority_class;
 		if (database_id.empty())
 		{
 			if (boost::algorithm::iequals(protocol, std::string("LOG")) == 1)
 			{
-				protocol_data.protocol.reset(new LOG());
+				protocol_data->protocol.reset(new LOG());
 			}	else {
 				status = false;
 				std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
@@ -449,11 +517,11 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 		{
 			if (boost::algorithm::iequals(protocol, std::string("SQL")) == 1)
 			{
-				protocol_data.protocol.reset(new SQL());
+				protocol_data->protocol.reset(new SQL());
 			}
 			else if (boost::algorithm::iequals(protocol, std::string("SQL_CUSTOM")) == 1)
 			{
-				protocol_data.protocol.reset(new SQL_CUSTOM());
+				protocol_data->protocol.reset(new SQL_CUSTOM());
 			}	else {
 				status = false;
 				std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
@@ -463,10 +531,12 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 
 		if (status)
 		{
-			if (protocol_data.protocol->init(this, database_id, init_data))
+			if (protocol_data->protocol->init(this, database_id, init_data))
 			{
+				const std::size_t protocol_handle = vec_protocols.size();
+				protocols_index[boost::string_view(protocol_data->name)] = protocol_handle;
 				vec_protocols.push_back(std::move(protocol_data));
-				std::strcpy(output, "[1]");
+				std::strcpy(output, ("[1," + std::to_string(protocol_handle) + "]").c_str());
 			}	else {
 				std::strcpy(output, "[0,\"Failed to Load Protocol\"]");
 				logger->warn("extDB3: Failed to Load Protocol: {0}", protocol);
@@ -476,176 +546,275 @@ void Ext::addProtocol(char *output, const std::string &database_id, const std::s
 }
 
 
-void Ext::getSinglePartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id)
-// Gets Result String from unordered map array -- Result Formt == Single-Message
-//   If <=, then sends output to arma, and removes entry from unordered map array
-//   If >, sends [5] to indicate MultiPartResult
+Ext::protocol_struct* Ext::findProtocol(const boost::string_view &protocol_name)
+// Protocol Name or #<Protocol Handle> returned from ADD_PROTOCOL / ADD_DATABASE_PROTOCOL
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
+	if ((protocol_name.size() > 1) && (protocol_name[0] == '#'))
+	{
+		std::size_t protocol_handle = 0;
+		for (auto itr = (protocol_name.begin() + 1); itr != protocol_name.end(); ++itr)
+		{
+			if ((*itr < '0') || (*itr > '9')) return nullptr;
+			protocol_handle = (protocol_handle * 10) + (*itr - '0');
+			if (protocol_handle >= vec_protocols.size()) return nullptr; // Also stops overflow wrapping back to a valid handle
+		}
+		if (protocol_handle < vec_protocols.size())
+		{
+			return vec_protocols[protocol_handle].get();
+		}
+		return nullptr;
+	}
 
-	auto const_itr = stored_results.find(unique_id);
-	if (const_itr == stored_results.end()) // NO UNIQUE ID
+	auto const_itr = protocols_index.find(protocol_name);
+	if (const_itr == protocols_index.end())
 	{
-		std::strcpy(output, "");
+		return nullptr;
 	}
-	else // SEND MSG (Part)
+	return vec_protocols[const_itr->second].get();
+}
+
+
+void Ext::syncCallProtocol(char *output, const int &output_size, std::string &input_str)
+// Sync callPlugin
+{
+	const std::string::size_type found = input_str.find(":",2);
+
+	if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
 	{
-		if (const_itr->second.wait) // WAIT
-		{
-			std::strcpy(output, "[3]");
-		}
-		else if (const_itr->second.message.length() > output_size)
+		std::strcpy(output, "[0,\"Error Invalid Format\"]");
+		logger->error("extDB3: Invalid Format: {0}", input_str);
+	}
+	else
+	{
+		protocol_struct *protocol_data = findProtocol(boost::string_view(input_str).substr(2, (found - 2)));
+		if (protocol_data == nullptr)
 		{
-			std::strcpy(output, "[5]");
+			std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
 		}
 		else
 		{
-			std::strcpy(output, const_itr->second.message.c_str());
-			stored_results.erase(const_itr);
+			resultData result_data;
+			result_data.message = buffer_pool.acquire(output_size);
+
+			protocol_data->protocol->callProtocol(input_str.substr(found+1), result_data.message, false);
+			if (result_data.message.length() <= output_size)
+			{
+				std::strcpy(output, result_data.message.c_str());
+				buffer_pool.release(result_data.message);
+			}
+			else
+			{
+				const unsigned long unique_id = stored_results.add(result_data, output_size);
+				std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
+			}
 		}
 	}
 }
 
 
-void Ext::getMultiPartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id)
-// Gets Result String from unordered map array  -- Result Format = Multi-Message
-//   If length of String = 0, sends arma "", and removes entry from unordered map array
-//   If <=, then sends output to arma
-//   If >, then sends 1 part to arma + stores rest.
+void Ext::onewayCallProtocol(AbstractProtocol *protocol, const std::string &data)
+// ASync callProtocol
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
+	resultData result_data;
+	result_data.message = buffer_pool.acquire(0);
+	protocol->callProtocol(data, result_data.message, true);
+	buffer_pool.release(result_data.message);
+}
 
-	auto const_itr = stored_results.find(unique_id);
-	if (const_itr == stored_results.end()) // NO UNIQUE ID or WAIT
-	{
-		std::strcpy(output, "");
-	}
-	else if (const_itr->second.wait)
+
+void Ext::asyncCallProtocol(const int &output_size, AbstractProtocol *protocol, const std::string &data, const unsigned long unique_id)
+// ASync + Save callProtocol
+// Protocol is resolved by callExtension, so worker threads never touch the protocol registry
+{
+	resultData result_data;
+	result_data.message = buffer_pool.acquire(output_size); // Ownership passes to stored_results, recycled once sent
+	if (protocol->callProtocol(data, result_data.message, true, unique_id))
 	{
-		std::strcpy(output, "[3]");
+		stored_results.save(unique_id, result_data, output_size);
+	} else {
+		buffer_pool.release(result_data.message);
 	}
-	else if (const_itr->second.message.empty()) // END of MSG
+}
+
+
+void Ext::batchCallProtocols(char *output, const int &output_size, std::string &input_str)
+// 6:[[<Protocol>,<Data>],...] Queues every call in one go, returns a single id for [1,[<result>,...]]
+//   Protocols are resolved here on the main thread, invalid entries get an error result in their slot
+{
+	std::string batch_str = input_str.substr(2);
+	std::vector<std::string> entries;
+	if ((!sqf::parser(batch_str, entries, true)) || (entries.empty()))
 	{
-		stored_results.erase(const_itr);
-		std::strcpy(output, "");
+		std::strcpy(output, "[0,\"Error Invalid Format\"]");
+		logger->error("extDB3: Error Invalid Format: {0}", input_str);
+		return;
 	}
-	else // SEND MSG (Part)
+
+	std::shared_ptr<batch_struct> batch(new batch_struct());
+	batch->results.resize(entries.size());
+	batch->output_size = output_size;
+
+	std::vector<std::size_t> jobs_index;
+	std::vector<std::vector<std::string>> jobs_tokens;
+	std::vector<protocol_struct*> jobs_protocol;
+	for (std::size_t i = 0; i < entries.size(); ++i)
 	{
-		if (const_itr->second.message.length() > output_size)
+		std::vector<std::string> tokens;
+		if ((entries[i].empty()) || (entries[i].front() != '[') || (!sqf::parser(entries[i], tokens)) || (tokens.size() != 2))
 		{
-			std::strcpy(output, const_itr->second.message.substr(0, output_size).c_str());
-			const_itr->second.message = const_itr->second.message.substr(output_size);
+			batch->results[i] = "[0,\"Error Invalid Format\"]";
+			logger->error("extDB3: Error Invalid Format: {0}", entries[i]);
+			continue;
 		}
-		else
+		protocol_struct *protocol_data = findProtocol(boost::string_view(tokens[0]));
+		if (protocol_data == nullptr)
+		{
+			batch->results[i] = "[0,\"Error Unknown Protocol\"]";
+			logger->error("extDB3: Error Unknown Protocol: {0}", tokens[0]);
+			continue;
+		}
+		jobs_index.push_back(i);
+		jobs_tokens.push_back(std::move(tokens));
+		jobs_protocol.push_back(protocol_data);
+	}
+
+	batch->unique_id = stored_results.reserve();
+	batch->remaining = jobs_index.size();
+	if (jobs_index.empty())
+	{
+		batchSave(*batch);
+	}	else {
+		for (std::size_t i = 0; i < jobs_index.size(); ++i)
 		{
-			std::strcpy(output, const_itr->second.message.c_str());
-			const_itr->second.message.clear();
+			worker_pool.post(boost::bind(&Ext::batchCallProtocol, this, batch, jobs_index[i], jobs_protocol[i]->protocol.get(), jobs_tokens[i][1]), jobs_protocol[i]->priority);
 		}
 	}
+	std::strcpy(output, ("[2,\"" + std::to_string(batch->unique_id) + "\"]").c_str());
 }
 
 
-const unsigned long Ext::saveResult_mutexlock(const resultData &result_data)
-// Stores Result String and returns Unique ID, used by SYNC Calls where message > outputsize
+void Ext::batchCallProtocol(std::shared_ptr<batch_struct> batch, const std::size_t index, AbstractProtocol *protocol, const std::string &data)
+// ASync Batch Entry callProtocol
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-	const unsigned long unique_id = unique_id_counter++;
-	stored_results[unique_id] = std::move(result_data);
-	stored_results[unique_id].wait = false;
-	return unique_id;
+	std::string &result = batch->results[index];
+	result = buffer_pool.acquire(batch->output_size);
+	protocol->callProtocol(data, result, true, batch->unique_id);
+	if (result.empty())
+	{
+		result = "[0]";
+	}
+	if (--(batch->remaining) == 0)
+	{
+		batchSave(*batch);
+	}
 }
 
 
-void Ext::saveResult_mutexlock(const unsigned long &unique_id, const resultData &result_data)
-// Stores Result String for Unique ID
+void Ext::batchSave(batch_struct &batch)
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-	stored_results[unique_id] = std::move(result_data);
-	stored_results[unique_id].wait = false;
+	std::size_t message_size = 5;
+	for (auto &result : batch.results)
+	{
+		message_size += result.size() + 1;
+	}
+
+	resultData result_data;
+	result_data.message = buffer_pool.acquire(message_size);
+	result_data.message += "[1,[";
+	for (std::size_t i = 0; i < batch.results.size(); ++i)
+	{
+		if (i > 0) result_data.message += ',';
+		result_data.message += batch.results[i];
+		buffer_pool.release(batch.results[i]);
+	}
+	result_data.message += "]]";
+	stored_results.save(batch.unique_id, result_data, batch.output_size);
 }
 
 
-void Ext::saveResult_mutexlock(std::vector<unsigned long> &unique_ids, const resultData &result_data)
-// Stores Result for multiple Unique IDs (used by Rcon Backend)
+void Ext::fetchCursor(char *output, const int &output_size, const std::string &cursor_id_str, const std::string &num_rows_str, const bool async_method)
+// 9:FETCH:<Cursor ID>:<Rows>, Cursor is closed once it returns its last rows or fails
+//   9:FETCH_ASYNC:<Cursor ID>:<Rows> fetches on a worker thread, returns [2,"<ID>"] for 4:<ID> like 2: calls
 {
-	std::lock_guard<std::mutex> lock(mutex_results);
-	for (auto &unique_id : unique_ids)
+	const unsigned long cursor_id = strtoul(cursor_id_str.c_str(), NULL, 0);
+	const unsigned long num_rows = strtoul(num_rows_str.c_str(), NULL, 0);
+	if (num_rows == 0)
 	{
-		stored_results[unique_id] = result_data;
-		stored_results[unique_id].wait = false;
+		std::strcpy(output, "[0,\"Error Invalid Format\"]");
+		logger->error("extDB3: Error Invalid Format: FETCH Rows: {0}", num_rows_str);
+		return;
+	}
+
+	if (async_method)
+	{
+		const unsigned long unique_id = stored_results.reserve(output_size);
+		worker_pool.post(boost::bind(&Ext::asyncFetchCursor, this, output_size, cursor_id, num_rows, unique_id));
+		std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
+	}	else {
+		std::string result;
+		fetchCursor(cursor_id, num_rows, output_size, result);
+		std::strcpy(output, result.c_str());
 	}
 }
 
 
-void Ext::syncCallProtocol(char *output, const int &output_size, std::string &input_str)
-// Sync callPlugin
+void Ext::asyncFetchCursor(const int &output_size, const unsigned long cursor_id, const unsigned long num_rows, const unsigned long unique_id)
 {
-	const std::string::size_type found = input_str.find(":",2);
+	resultData result_data;
+	result_data.message = buffer_pool.acquire(output_size);
+	fetchCursor(cursor_id, num_rows, output_size, result_data.message);
+	stored_results.save(unique_id, result_data, output_size);
+}
 
-	if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
+
+void Ext::fetchCursor(const unsigned long cursor_id, const unsigned long num_rows, const int &output_size, std::string &result)
+{
+	try
 	{
-		std::strcpy(output, "[0,\"Error Invalid Format\"]");
-		logger->error("extDB3: Invalid Format: {0}", input_str);
+		cursors.fetch(cursor_id, num_rows, output_size, result);
 	}
-	else
+	catch (MariaDBStatementException1 &e)
 	{
-		std::string protocol_name = input_str.substr(2, (found - 2));
-		auto const_itr = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-		if (const_itr == vec_protocols.end())
-		{
-			std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
-		}
-		else
-		{
-			resultData result_data;
-			result_data.message.reserve(output_size);
-
-			const_itr->protocol->callProtocol(input_str.substr(found+1), result_data.message, false);
-			if (result_data.message.length() <= output_size)
-			{
-				std::strcpy(output, result_data.message.c_str());
-			}
-			else
-			{
-				const unsigned long unique_id = saveResult_mutexlock(result_data);
-				std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
-			}
-		}
+		#ifdef DEBUG_TESTING
+			console->error("extDB3: Cursor: Error MariaDBStatementException1: {0}", e.what());
+		#endif
+		logger->error("extDB3: Cursor: Error MariaDBStatementException1: {0}", e.what());
+		result = "[0,\"Error MariaDBStatementException1 Exception\"]";
+	}
+	catch (extDB3Exception &e)
+	{
+		#ifdef DEBUG_TESTING
+			console->error("extDB3: Cursor: Error extDB3Exception: {0}", e.what());
+		#endif
+		logger->error("extDB3: Cursor: Error extDB3Exception: {0}", e.what());
+		result = "[0,\"Error extDB3Exception Exception\"]";
 	}
 }
 
 
-void Ext::onewayCallProtocol(std::string &input_str)
-// ASync callProtocol
+void Ext::getPoolStats(char *output, const std::string &database_id)
+// 9:POOL_STATS:<Database ID>
 {
-	const std::string::size_type found = input_str.find(":",2);
-	if ((found==std::string::npos) || (found == (input_str.size() - 1)))
-	{
-		logger->error("extDB3: Invalid Format: {0}", input_str);
-	}
-	else
+	auto database_itr = mariadb_databases.find(database_id);
+	if (database_itr != mariadb_databases.end())
 	{
-		std::string protocol_name = input_str.substr(2, (found - 2));
-		auto const_itr = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-		if (const_itr != vec_protocols.end())
-		{
-			resultData result_data;
-			const_itr->protocol->callProtocol(input_str.substr(found+1), result_data.message, true);
-		}
+		std::string result;
+		database_itr->second.getStats(result);
+		std::strcpy(output, result.c_str());
+	}	else {
+		std::strcpy(output, "[0,\"Error Database Not Found\"]");
 	}
 }
 
 
-void Ext::asyncCallProtocol(const int &output_size, const std::string &protocol_name, const std::string &data, const unsigned long unique_id)
-// ASync + Save callProtocol
-// We check if Protocol exists here, since its a thread (less time spent blocking arma) and it shouldnt happen anyways
+void Ext::closeCursor(char *output, const std::string &cursor_id_str)
+// 9:CLOSE:<Cursor ID>
 {
-	resultData result_data;
-	result_data.message.reserve(output_size);
-	auto const_itr = (std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; }));
-	if (const_itr->protocol->callProtocol(data, result_data.message, true, unique_id))
+	if (cursors.close(strtoul(cursor_id_str.c_str(), NULL, 0)))
 	{
-		saveResult_mutexlock(unique_id, result_data);
+		std::strcpy(output, "[1]");
+	}	else {
+		std::strcpy(output, "[0,\"Error Cursor Not Found\"]");
 	}
 }
 
@@ -954,7 +1123,17 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 			{
 				case '1': //ASYNC
 				{
-					io_service.post(boost::bind(&Ext::onewayCallProtocol, this, std::move(input_str)));
+					const std::string::size_type found = input_str.find(":", 2);
+					if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
+					{
+						logger->error("extDB3: Invalid Format: {0}", input_str);
+					}	else {
+						protocol_struct *protocol_data = findProtocol(boost::string_view(input_str).substr(2, (found - 2)));
+						if (protocol_data != nullptr)
+						{
+							worker_pool.post(boost::bind(&Ext::onewayCallProtocol, this, protocol_data->protocol.get(), input_str.substr(found+1)), protocol_data->priority);
+						}
+					}
 					break;
 				}
 				case '2': //ASYNC + SAVE
@@ -968,36 +1147,66 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 					}	else {
 						// Check for Protocol Name Exists...
 						// Do this so if someone manages to get server, the error message wont get stored in the result unordered map
-						const std::string protocol_name = input_str.substr(2,(found-2));
-						if ((std::find_if(vec_protocols.begin(), vec_protocols.end(), [=](const protocol_struct& elem) { return protocol_name == elem.name; })) != vec_protocols.end()) //TODO Change to ITER
+						protocol_struct *protocol_data = findProtocol(boost::string_view(input_str).substr(2, (found - 2)));
+						if (protocol_data != nullptr)
+						{
+							const unsigned long unique_id = stored_results.reserve(output_size);
+							worker_pool.post(boost::bind(&Ext::asyncCallProtocol, this, output_size, protocol_data->protocol.get(), input_str.substr(found+1), unique_id), protocol_data->priority);
+							std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
+						}	else {
+							std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
+							logger->error("extDB3: Error Unknown Protocol: {0}", input_str);
+						}
+					}
+					break;
+				}
+				case '3': //ASYNC + SAVE -- Priority Override 3:<HIGH|NORMAL|LOW>:<Protocol>:<Data>
+				{
+					const std::string::size_type found_priority = input_str.find(":", 2);
+					const std::string::size_type found = (found_priority == std::string::npos) ? std::string::npos : input_str.find(":", (found_priority + 1));
+					WorkerPool::priority_class priority;
+					if ((found==std::string::npos) || (found == (call_extension_input_str_length - 1)))
+					{
+						std::strcpy(output, "[0,\"Error Invalid Format\"]");
+						logger->error("extDB3: Error Invalid Format: {0}", input_str);
+					}
+					else if (!WorkerPool::getPriorityClass(input_str.substr(2, (found_priority - 2)), priority))
+					{
+						std::strcpy(output, "[0,\"Error Invalid Priority\"]");
+						logger->error("extDB3: Error Invalid Priority: {0}", input_str);
+					}	else {
+						protocol_struct *protocol_data = findProtocol(boost::string_view(input_str).substr((found_priority + 1), (found - found_priority - 1)));
+						if (protocol_data != nullptr)
 						{
-							unsigned long unique_id;
-							{
-								std::lock_guard<std::mutex> lock(mutex_results);
-								unique_id = unique_id_counter++;
-								stored_results[unique_id].wait = true;
-							}
-							io_service.post(boost::bind(&Ext::asyncCallProtocol, this, output_size, std::move(protocol_name), input_str.substr(found+1), std::move(unique_id)));
+							const unsigned long unique_id = stored_results.reserve(output_size);
+							worker_pool.post(boost::bind(&Ext::asyncCallProtocol, this, output_size, protocol_data->protocol.get(), input_str.substr(found+1), unique_id), priority);
 							std::strcpy(output, ("[2,\"" + std::to_string(unique_id) + "\"]").c_str());
 						}	else {
 							std::strcpy(output, "[0,\"Error Unknown Protocol\"]");
-							logger->error("extDB3: Error Unknown Protocol: {0}  Input String: {1}", protocol_name, input_str);
+							logger->error("extDB3: Error Unknown Protocol: {0}", input_str);
 						}
 					}
 					break;
 				}
+				case '6': //ASYNC + SAVE -- Batch 6:[[<Protocol>,<Data>],...]
+				{
+					batchCallProtocols(output, output_size, input_str);
+					break;
+				}
 				case '4': // GET -- Single-Part Message Format
 				{
 					//const unsigned long unique_id = std::stoul(input_str.substr(2));
-					const unsigned long unique_id = strtoul (input_str.substr(2).c_str(), NULL, 0);
-					getSinglePartResult_mutexlock(output, output_size, unique_id);
+					char *unique_id_end;
+					const unsigned long unique_id = strtoul (input_str.c_str() + 2, &unique_id_end, 0);
+					// 4:<ID>:CHUNKS == Multi-Part Message returns [5,<number of parts>]
+					stored_results.getSinglePart(output, output_size, unique_id, (std::strcmp(unique_id_end, ":CHUNKS") == 0));
 					break;
 				}
 				case '5': // GET -- Multi-Part Message Format
 				{
 					//const unsigned long unique_id = std::stoul(input_str.substr(2));
 					const unsigned long unique_id = strtoul (input_str.substr(2).c_str(), NULL, 0);
-					getMultiPartResult_mutexlock(output, output_size, unique_id);
+					stored_results.getMultiPart(output, output_size, unique_id);
 					break;
 				}
 				case '0': //SYNC
@@ -1020,6 +1229,14 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 									std::string result;
 									getDateAdd(tokens[2],tokens[3],result);
 									std::strcpy(output, result.c_str());
+								}
+								else if (tokens[1] == "FETCH")
+								{
+									fetchCursor(output, output_size, tokens[2], tokens[3]);
+								}
+								else if (tokens[1] == "FETCH_ASYNC")
+								{
+									fetchCursor(output, output_size, tokens[2], tokens[3], true);
 								}	else {
 									std::strcpy(output, "[0,\"Error Invalid Format\"]");
 									logger->error("extDB3: Error Invalid Format: {0}", input_str);
@@ -1050,6 +1267,14 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 									getUTCTime(tokens[2], result);
 									std::strcpy(output, result.c_str());
 								}
+								else if (tokens[1] == "CLOSE")
+								{
+									closeCursor(output, tokens[2]);
+								}
+								else if (tokens[1] == "POOL_STATS")
+								{
+									getPoolStats(output, tokens[2]);
+								}
 								else if (tokens[1] == "UNLOCK")
 								{
 									std::strcpy(output, ("[0]"));
@@ -1089,6 +1314,24 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								{
 									std::strcpy(output, "[1]");
 								}
+								else if (tokens[1] == "BUFFER_POOL_STATS")
+								{
+									std::string result;
+									buffer_pool.getStats(result);
+									std::strcpy(output, result.c_str());
+								}
+								else if (tokens[1] == "WORKER_STATS")
+								{
+									std::string result;
+									worker_pool.getStats(result);
+									std::strcpy(output, result.c_str());
+								}
+								else if (tokens[1] == "QUEUE_STATS")
+								{
+									std::string result;
+									worker_pool.getQueueStats(result);
+									std::strcpy(output, result.c_str());
+								}
 								else if (tokens[1] == "VERSION")
 								{
 									std::strcpy(output, EXTDB_VERSION);
@@ -1132,6 +1375,24 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								{
 									std::strcpy(output, "[0]");
 								}
+								else if (tokens[1] == "BUFFER_POOL_STATS")
+								{
+									std::string result;
+									buffer_pool.getStats(result);
+									std::strcpy(output, result.c_str());
+								}
+								else if (tokens[1] == "WORKER_STATS")
+								{
+									std::string result;
+									worker_pool.getStats(result);
+									std::strcpy(output, result.c_str());
+								}
+								else if (tokens[1] == "QUEUE_STATS")
+								{
+									std::string result;
+									worker_pool.getQueueStats(result);
+									std::strcpy(output, result.c_str());
+								}
 								else if (tokens[1] == "UNLOCK")
 								{
 									std::strcpy(output, "[1]");
@@ -1186,6 +1447,14 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								{
 									connectDatabase(output, tokens[2], tokens[2]);
 								}
+								else if (tokens[1] == "CLOSE")
+								{
+									closeCursor(output, tokens[2]);
+								}
+								else if (tokens[1] == "POOL_STATS")
+								{
+									getPoolStats(output, tokens[2]);
+								}
 								else if (tokens[1] == "LOCK")
 								{
 									ext_info.extDB_lock = true;
@@ -1215,6 +1484,14 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 									getDateAdd(tokens[2],tokens[3],result);
 									std::strcpy(output, result.c_str());
 								}
+								else if (tokens[1] == "FETCH")
+								{
+									fetchCursor(output, output_size, tokens[2], tokens[3]);
+								}
+								else if (tokens[1] == "FETCH_ASYNC")
+								{
+									fetchCursor(output, output_size, tokens[2], tokens[3], true);
+								}
 								else
 								{
 									// Invalid Format
@@ -1243,6 +1520,22 @@ void Ext::callExtension(char *output, const int &output_size, const char *functi
 								{
 									addProtocol(output, tokens[2], tokens[3], tokens[4], tokens[5]); // ADD Database Protocol + Options
 								}
+								else if (tokens[1] == "ADD_PROTOCOL")
+								{
+									addProtocol(output, "", tokens[2], tokens[3], tokens[4], tokens[5]); // ADD + Init Options + Priority
+								}
+								else
+								{
+									// Invalid Format
+									std::strcpy(output, "[0,\"Error Invalid Format\"]");
+									logger->error("extDB3: Error Invalid Format: {0}", input_str);
+								}
+								break;
+							case 7:
+								if (tokens[1] == "ADD_DATABASE_PROTOCOL")
+								{
+									addProtocol(output, tokens[2], tokens[3], tokens[4], tokens[5], tokens[6]); // ADD Database Protocol + Options + Priority
+								}
 								else
 								{
 									// Invalid Format
@@ -5,19 +5,26 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <unordered_map>
 
 #include <boost/asio.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/random/random_device.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/utility/string_view.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "abstract_ext.h"
+#include "buffer_pool.h"
+#include "cursor_store.h"
+#include "result_store.h"
+#include "worker_pool.h"
 
 #include "protocols/abstract_protocol.h"
 
@@ -36,6 +43,24 @@ public:
 	{
 		std::string													name;
 		std::unique_ptr<AbstractProtocol>		protocol;
+		WorkerPool::priority_class					priority = WorkerPool::NORMAL;
+	};
+
+	struct batch_struct
+	// 6: Batch, shared by all its queued calls, last call to finish saves the combined result
+	{
+		std::vector<std::string>		results;
+		std::atomic<std::size_t>		remaining;
+		unsigned long								unique_id;
+		int													output_size;
+	};
+
+	struct string_view_hash
+	{
+		std::size_t operator()(const boost::string_view &str) const
+		{
+			return boost::hash_range(str.begin(), str.end());
+		}
 	};
 
 
@@ -47,24 +72,26 @@ private:
 	std::string::size_type input_str_length;
 
 	// Main ASIO Thread Queue
-	std::unique_ptr<boost::asio::io_service::work> io_work_ptr;
 	boost::asio::io_service io_service;
-	boost::thread_group threads;
+	WorkerPool worker_pool;
 
 	std::mutex mutex_mariadb_idle_cleanup_timer;
 	std::unique_ptr<boost::asio::deadline_timer> mariadb_idle_cleanup_timer;
+	boost::asio::io_service::strand mariadb_maintenance_strand; // idleCleanup + Pool Health Checks, never run concurrently
 
 	// Protocols
-	std::vector<protocol_struct> vec_protocols;
+	//   vec_protocols index == protocol handle, protocols_index keys are views of the interned protocol_struct names
+	std::vector<std::unique_ptr<protocol_struct>> vec_protocols;
+	std::unordered_map<boost::string_view, std::size_t, string_view_hash> protocols_index;
 	std::mutex mutex_vec_protocols;
 
-	// Unique ID
+	// Input
 	std::string::size_type call_extension_input_str_length;
-	unsigned long unique_id_counter = 100; // Can't be value 1
 
-	// Results
-	std::unordered_map<unsigned long, resultData> stored_results;
-	std::mutex mutex_results;  // Using Same Lock for Unique ID aswell
+	// Results + Unique ID
+	BufferPool buffer_pool;
+	ResultStore stored_results;
+	CursorStore cursors;
 
 	// UPTimer
 	std::chrono::time_point<std::chrono::steady_clock> uptime_start;
@@ -78,19 +105,25 @@ private:
 
 	void search(boost::filesystem::path &extDB_config_path, bool &conf_found, bool &conf_randomized);
 
+	void initDatabase(MariaDBPool &database_pool, const std::string &database_conf);
 	void connectDatabase(char *output, const std::string &database_conf, const std::string &database_id);
+	void getPoolStats(char *output, const std::string &database_id);
 
 	// Protocols
-	void addProtocol(char *output, const std::string &database_id, const std::string &protocol, const std::string &protocol_name, const std::string &init_data);
-	void getSinglePartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id);
-	void getMultiPartResult_mutexlock(char *output, const int &output_size, const unsigned long &unique_id);
+	void addProtocol(char *output, const std::string &database_id, const std::string &protocol, const std::string &protocol_name, const std::string &init_data, const std::string &priority="NORMAL");
+	protocol_struct* findProtocol(const boost::string_view &protocol_name);
 	void syncCallProtocol(char *output, const int &output_size, std::string &input_str);
-	void onewayCallProtocol(std::string &input_str);
-	void asyncCallProtocol(const int &output_size, const std::string &protocol_name, const std::string &data, const unsigned long unique_id);
-
-	const unsigned long saveResult_mutexlock(const resultData &result_data);
-	void saveResult_mutexlock(const unsigned long &unique_id, const resultData &result_data);
-	void saveResult_mutexlock(std::vector<unsigned long> &unique_ids, const resultData &result_data);
+	void onewayCallProtocol(AbstractProtocol *protocol, const std::string &data);
+	void asyncCallProtocol(const int &output_size, AbstractProtocol *protocol, const std::string &data, const unsigned long unique_id);
+	void batchCallProtocols(char *output, const int &output_size, std::string &input_str);
+	void batchCallProtocol(std::shared_ptr<batch_struct> batch, const std::size_t index, AbstractProtocol *protocol, const std::string &data);
+	void batchSave(batch_struct &batch);
+
+	// Cursors
+	void fetchCursor(char *output, const int &output_size, const std::string &cursor_id_str, const std::string &num_rows_str, const bool async_method=false);
+	void asyncFetchCursor(const int &output_size, const unsigned long cursor_id, const unsigned long num_rows, const unsigned long unique_id);
+	void fetchCursor(const unsigned long cursor_id, const unsigned long num_rows, const int &output_size, std::string &result);
+	void closeCursor(char *output, const std::string &cursor_id_str);
 
 	void getUPTime(std::string &token, std::string &result);
 	void getUPTime2(std::string &token, std::string &result);
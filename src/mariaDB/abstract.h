@@ -25,5 +25,9 @@ struct sql_option
 
 	bool strip = false;
 
+	// Typed Input, Prepared Statements bind the value natively instead of as a string
+	enum value_types { VALUE_STRING, VALUE_INT, VALUE_BIGINT, VALUE_DOUBLE };
+	value_types value_type = VALUE_STRING;
+
 	int value_number = -1;
 };
@@ -7,6 +7,8 @@
 
 #include <iostream>
 
+#include <errmsg.h>
+
 #include "exceptions.h"
 
 
@@ -24,13 +26,14 @@ MariaDBConnector::~MariaDBConnector(void)
 }
 
 
-void MariaDBConnector::init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db)
+void MariaDBConnector::init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db, const options_struct &options)
 {
 	login_data.host = host;
 	login_data.port = port;
 	login_data.user = user;
 	login_data.password = password;
 	login_data.db = db;
+	login_data.options = options;
 }
 
 
@@ -39,17 +42,67 @@ void MariaDBConnector::connect()
 	if (connected)
 	{
 		mysql_close(mysql_ptr);
+		mysql_ptr = NULL;
+		connected = false;
 	}
 	mysql_ptr = mysql_init(mysql_ptr);
-	//mysql_optionsv(mysql_ptr, MYSQL_OPT_COMPRESS, NULL); // Compression
-	//mysql_optionsv(mysql_ptr, MYSQL_OPT_CONNECT_TIMEOUT, (const char *)5);
 	mysql_optionsv(mysql_ptr, MYSQL_OPT_RECONNECT, (void *)"1");
 	mysql_optionsv(mysql_ptr, MYSQL_SET_CHARSET_NAME, (void *)"utf8");
-	if (!(mysql_real_connect(mysql_ptr, login_data.host.c_str(), login_data.user.c_str(), login_data.password.c_str(), login_data.db.c_str(), login_data.port, 0, 0)))
+
+	const options_struct &options = login_data.options;
+	if (options.compress)
 	{
-		throw MariaDBConnectorException(mysql_ptr);
+		mysql_optionsv(mysql_ptr, MYSQL_OPT_COMPRESS, NULL); // Worth it for large results over a slow link, costs CPU both ends
+	}
+	if (options.connect_timeout > 0)
+	{
+		mysql_optionsv(mysql_ptr, MYSQL_OPT_CONNECT_TIMEOUT, &options.connect_timeout);
+	}
+	if (options.read_timeout > 0)
+	{
+		mysql_optionsv(mysql_ptr, MYSQL_OPT_READ_TIMEOUT, &options.read_timeout);
+	}
+	if (options.write_timeout > 0)
+	{
+		mysql_optionsv(mysql_ptr, MYSQL_OPT_WRITE_TIMEOUT, &options.write_timeout);
+	}
+	if (!options.socket.empty())
+	{
+		#ifdef _WIN32
+			unsigned int protocol = MYSQL_PROTOCOL_PIPE;
+		#else
+			unsigned int protocol = MYSQL_PROTOCOL_SOCKET;
+		#endif
+		mysql_optionsv(mysql_ptr, MYSQL_OPT_PROTOCOL, &protocol);
+	}
+	if (options.tls)
+	{
+		my_bool enforce = 1;
+		my_bool verify = options.tls_verify_server ? 1 : 0;
+		mysql_ssl_set(mysql_ptr,
+			options.tls_key.empty() ? NULL : options.tls_key.c_str(),
+			options.tls_cert.empty() ? NULL : options.tls_cert.c_str(),
+			options.tls_ca.empty() ? NULL : options.tls_ca.c_str(),
+			NULL, NULL);
+		mysql_optionsv(mysql_ptr, MYSQL_OPT_SSL_ENFORCE, &enforce);
+		mysql_optionsv(mysql_ptr, MYSQL_OPT_SSL_VERIFY_SERVER_CERT, &verify);
+	}
+
+	unsigned long client_flags = 0;
+	if (options.multi_statements)
+	{
+		client_flags |= CLIENT_MULTI_STATEMENTS; // Only when Database Config allows it, multi statements make SQL injection worse
+	}
+	if (!(mysql_real_connect(mysql_ptr, login_data.host.c_str(), login_data.user.c_str(), login_data.password.c_str(), login_data.db.c_str(), login_data.port,
+		(options.socket.empty() ? NULL : options.socket.c_str()), client_flags)))
+	{
+		MariaDBConnectorException e(mysql_ptr);
+		mysql_close(mysql_ptr);
+		mysql_ptr = NULL;
+		throw e;
 	}
 	connected = true;
+	thread_id = mysql_thread_id(mysql_ptr);
 }
 
 
@@ -63,6 +116,41 @@ int MariaDBConnector::ping()
 	return (mysql_ping(mysql_ptr));
 }
 
+bool MariaDBConnector::connectionLost()
+// Last error was the server going away / unreachable, not a problem with the query itself
+{
+	const unsigned int error_code = mysql_errno(mysql_ptr);
+	return ((error_code == CR_SERVER_GONE_ERROR) || (error_code == CR_SERVER_LOST) || (error_code == CR_CONNECTION_ERROR) || (error_code == CR_CONN_HOST_ERROR));
+}
+
+
+bool MariaDBConnector::reconnected()
+// True once after an automatic reconnect, server side prepared statements from before it are gone
+{
+	unsigned long current_thread_id = mysql_thread_id(mysql_ptr);
+	if (current_thread_id != thread_id)
+	{
+		thread_id = current_thread_id;
+		return true;
+	}
+	return false;
+}
+
+
+void MariaDBConnector::discardResults()
+// Frees any results still pending from a multi statement query, so the connection can be reused
+{
+	while (mysql_more_results(mysql_ptr))
+	{
+		if (mysql_next_result(mysql_ptr) != 0) break;
+		MYSQL_RES *result = mysql_store_result(mysql_ptr);
+		if (result)
+		{
+			mysql_free_result(result);
+		}
+	}
+}
+
 
 std::string MariaDBConnector::escapeString(std::string &input_str)
 {
@@ -16,15 +16,36 @@ public:
 	MariaDBConnector();
 	~MariaDBConnector();
 
-	void init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db);
+	struct options_struct
+	// Per Database Config Section, 0 / empty == MariaDB Connector default
+	{
+		bool multi_statements = false;
+		bool compress = false;
+		unsigned int connect_timeout = 0; // Seconds
+		unsigned int read_timeout = 0;    // Seconds
+		unsigned int write_timeout = 0;   // Seconds
+		std::string socket;               // Unix Socket path / Windows Named Pipe name, instead of TCP
+
+		bool tls = false;                 // Connection fails if the server doesn't support TLS
+		bool tls_verify_server = false;
+		std::string tls_ca;
+		std::string tls_cert;
+		std::string tls_key;
+	};
+
+	void init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db, const options_struct &options);
 	void connect();
 	unsigned long long getInsertId();
 	int ping();
+	bool connectionLost();
+	bool reconnected();
+	void discardResults();
 
-	MYSQL *mysql_ptr;
+	MYSQL *mysql_ptr = NULL;
 
 private:
 	bool connected = false;
+	unsigned long thread_id = 0; // Server Connection ID, changes if MYSQL_OPT_RECONNECT reconnected
 
 	struct login_data_struct
 	{
@@ -33,6 +54,7 @@ private:
 		std::string password;
 		std::string db;
 		unsigned int port;
+		options_struct options;
 	};
 	login_data_struct login_data;
 
@@ -0,0 +1,68 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "cursor.h"
+
+#include "exceptions.h"
+#include "row_sink.h"
+
+
+MariaDBCursor::MariaDBCursor(MariaDBPool *database_pool, const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, const bool read_only) : session(database_pool, read_only), output_transforms(output_transforms), strip_chars_mode(strip_chars_mode)
+{
+	last_used = boost::posix_time::second_clock::local_time();
+}
+
+
+void MariaDBCursor::open(std::string &sql_query, std::vector<MariaDBStatement::mysql_bind_param> &params, const unsigned long prefetch_rows)
+{
+	statement.init(session.data->connector);
+	statement.create();
+	statement.prepare(sql_query);
+	statement.bindParams(params);
+	statement.executeCursor(prefetch_rows);
+	readNextRow();
+}
+
+
+void MariaDBCursor::readNextRow()
+{
+	if (next_row.empty() && more_rows)
+	{
+		MariaDBSQFRowSink sink(next_row);
+		more_rows = statement.fetch(output_transforms, strip_chars_mode, sink, 1);
+	}
+}
+
+
+bool MariaDBCursor::fetch(const std::size_t max_rows, const std::size_t max_size, std::string &output)
+// Appends upto max_rows rows i.e [1,"abc"],[2,"def"] to output, without output growing more than max_size
+//   A row that doesn't fit is kept for the next fetch, returns false once there are no rows left
+{
+	last_used = boost::posix_time::second_clock::local_time();
+
+	const std::size_t start = output.size();
+	std::size_t num_rows = 0;
+	while ((!next_row.empty()) && (num_rows < max_rows))
+	{
+		const std::size_t row_size = next_row.size() + ((num_rows > 0) ? 1 : 0);
+		if ((output.size() - start + row_size) > max_size)
+		{
+			if (num_rows == 0)
+			{
+				throw extDB3Exception("Cursor Row is bigger than Output Size");
+			}
+			break;
+		}
+		if (num_rows > 0)
+		{
+			output += ',';
+		}
+		output += next_row;
+		next_row.clear();
+		++num_rows;
+		readNextRow();
+	}
+	return !next_row.empty();
+}
@@ -0,0 +1,43 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "session.h"
+#include "statement.h"
+#include "transform.h"
+
+
+class MariaDBCursor
+// Read only server side cursor, keeps its Prepared Statement open on a pinned MariaDBPool session until destroyed
+//   Rows are read from the server STMT_ATTR_PREFETCH_ROWS at a time, nothing is buffered beyond the next row
+{
+public:
+	MariaDBCursor(MariaDBPool *database_pool, const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, const bool read_only=false);
+
+	void open(std::string &sql_query, std::vector<MariaDBStatement::mysql_bind_param> &params, const unsigned long prefetch_rows);
+	bool fetch(const std::size_t max_rows, const std::size_t max_size, std::string &output);
+
+	boost::posix_time::ptime last_used;
+
+private:
+	// Declared before statement, statement has to be closed before the session goes back to the pool
+	MariaDBSession session;
+	MariaDBStatement statement;
+
+	std::vector<MariaDBTransform> output_transforms;
+	int strip_chars_mode;
+
+	// Next row as SQF Array text, read ahead to know if the cursor is finished
+	std::string next_row;
+	bool more_rows = true;
+
+	void readNextRow();
+};
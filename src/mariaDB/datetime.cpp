@@ -0,0 +1,148 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "datetime.h"
+
+#include <cstring>
+
+
+namespace
+{
+	bool readNumber(const char *&pos, const char *end, const int max_digits, unsigned int &value)
+	{
+		value = 0;
+		int digits = 0;
+		while ((pos < end) && (*pos >= '0') && (*pos <= '9') && (digits < max_digits))
+		{
+			value = (value * 10) + (*pos - '0');
+			++pos;
+			++digits;
+		}
+		return (digits > 0);
+	}
+
+
+	bool readSeparator(const char *&pos, const char *end, const char separator)
+	{
+		if ((pos < end) && (*pos == separator))
+		{
+			++pos;
+			return true;
+		}
+		return false;
+	}
+
+
+	void appendNumber(unsigned int value, std::string &output)
+	{
+		char buffer[10];
+		char *pos = buffer + sizeof(buffer);
+		do
+		{
+			*--pos = static_cast<char>('0' + (value % 10));
+			value /= 10;
+		} while (value > 0);
+		output.append(pos, (buffer + sizeof(buffer)) - pos);
+	}
+
+
+	unsigned int daysInMonth(const unsigned int year, const unsigned int month)
+	{
+		static const unsigned int days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+		if ((month == 2) && (((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0))))
+		{
+			return 29;
+		}
+		return days[month - 1];
+	}
+}
+
+
+bool MariaDBDateTime::parse(const char *value, std::size_t length, const formats format, MYSQL_TIME &time)
+// DATE YYYY-MM-DD, DATETIME YYYY-MM-DD HH:MM:SS[.ffffff], TIME HHH:MM:SS
+//   Returns false for zero / invalid dates + negative times, same range as boost::gregorian (1400-9999)
+{
+	std::memset(&time, 0, sizeof(MYSQL_TIME));
+	const char *pos = value;
+	const char *end = value + length;
+
+	if (format != TIME)
+	{
+		if (!(readNumber(pos, end, 4, time.year) && readSeparator(pos, end, '-') &&
+			readNumber(pos, end, 2, time.month) && readSeparator(pos, end, '-') &&
+			readNumber(pos, end, 2, time.day)))
+		{
+			return false;
+		}
+		if ((time.year < 1400) || (time.month < 1) || (time.month > 12) || (time.day < 1) || (time.day > daysInMonth(time.year, time.month)))
+		{
+			return false;
+		}
+		if (format == DATE)
+		{
+			return (pos == end);
+		}
+		if (!readSeparator(pos, end, ' '))
+		{
+			return false;
+		}
+	}
+
+	if (!(readNumber(pos, end, ((format == TIME) ? 3 : 2), time.hour) && readSeparator(pos, end, ':') &&
+		readNumber(pos, end, 2, time.minute) && readSeparator(pos, end, ':') &&
+		readNumber(pos, end, 2, time.second)))
+	{
+		return false;
+	}
+	if ((time.hour > ((format == TIME) ? 838u : 23u)) || (time.minute > 59) || (time.second > 59))
+	{
+		return false;
+	}
+	if (readSeparator(pos, end, '.'))
+	{
+		// Fractional Seconds, not part of SQF Time Array
+		while ((pos < end) && (*pos >= '0') && (*pos <= '9')) ++pos;
+	}
+	return (pos == end);
+}
+
+
+void MariaDBDateTime::append(const MYSQL_TIME &time, const formats format, std::string &output)
+{
+	output += '[';
+	if (format != TIME)
+	{
+		appendNumber(time.year, output);
+		output += ',';
+		appendNumber(time.month, output);
+		output += ',';
+		appendNumber(time.day, output);
+		if (format == DATE)
+		{
+			output += ']';
+			return;
+		}
+		output += ',';
+	}
+	appendNumber(time.hour, output);
+	output += ',';
+	appendNumber(time.minute, output);
+	output += ',';
+	appendNumber(time.second, output);
+	output += ']';
+}
+
+
+void MariaDBDateTime::convert(const char *value, std::size_t length, const formats format, std::string &output)
+// Invalid values are returned as []
+{
+	MYSQL_TIME time;
+	if (parse(value, length, format, time))
+	{
+		append(time, format, output);
+	}	else {
+		output += "[]";
+	}
+}
@@ -0,0 +1,23 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <string>
+
+#include <mysql.h>
+
+
+class MariaDBDateTime
+// DATE / DATETIME / TIME <-> SQF Time Array i.e 2017-01-31 23:59:00 -> [2017,1,31,23,59,0]
+//   Parses + formats in place, no streams, locales or allocations beyond output growing
+{
+public:
+	enum formats { DATE, DATETIME, TIME };
+
+	static bool parse(const char *value, std::size_t length, const formats format, MYSQL_TIME &time);
+	static void append(const MYSQL_TIME &time, const formats format, std::string &output);
+	static void convert(const char *value, std::size_t length, const formats format, std::string &output);
+};
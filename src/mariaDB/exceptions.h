@@ -26,13 +26,13 @@ private:
 class MariaDBConnectorException: public std::exception
 {
 public:
-	MariaDBConnectorException(MYSQL *mysql_ptr) : mysql_ptr(mysql_ptr) {}
+	MariaDBConnectorException(MYSQL *mysql_ptr) : msg(mysql_error(mysql_ptr)) {} // Copied, connect() closes the handle before throwing
 	virtual const char* what() const throw()
 	{
-  	return mysql_error(mysql_ptr);
+		return msg.c_str();
 	}
 private:
-	MYSQL *mysql_ptr;
+	std::string msg;
 };
 
 
@@ -5,15 +5,24 @@
 
 #include "pool.h"
 
+#include <exception>
+#include <vector>
+
 #include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 #include <mysql.h>
 
 #include "connector.h"
+#include "exceptions.h"
 
 
 
-MariaDBPool::MariaDBPool()
+MariaDBPool::MariaDBPool() : replica_unavailable_until(0)
 {
+	for (int i = 0; i < num_of_wait_buckets; ++i)
+	{
+		wait_histogram[i] = 0;
+	}
 }
 
 
@@ -22,35 +31,178 @@ MariaDBPool::~MariaDBPool(void)
 }
 
 
-void MariaDBPool::init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db)
+void MariaDBPool::init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db, const options_struct &options)
+// Opens min_connections in parallel before returning them all to Idle, throws MariaDBConnectorException if any fail
 {
 	login_data.host = host;
 	login_data.port = port;
 	login_data.user = user;
 	login_data.password = password;
 	login_data.db = db;
+	login_data.options = options;
+
+	unsigned int min_connections = (options.min_connections > 0) ? options.min_connections : 1;
+	if ((options.max_connections > 0) && (min_connections > options.max_connections))
+	{
+		min_connections = options.max_connections;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+		num_connections += min_connections;
+	}
+
+	std::vector<std::unique_ptr<mariadb_session_struct>> sessions(min_connections);
+	std::vector<std::exception_ptr> errors(sessions.size());
+	std::exception_ptr thread_error;
+	boost::thread_group threads;
+	try
+	{
+		for (std::size_t i = 0; i < sessions.size(); ++i)
+		{
+			threads.create_thread([this, &sessions, &errors, i]()
+			{
+				try
+				{
+					sessions[i] = connect();
+				}
+				catch (...)
+				{
+					errors[i] = std::current_exception();
+				}
+			});
+		}
+	}
+	catch (...)
+	{
+		thread_error = std::current_exception(); // Threads already started still reference sessions + errors
+	}
+	threads.join_all();
+	for (auto &session : sessions)
+	{
+		if (session)
+		{
+			putBack(std::move(session));
+		}	else {
+			releaseConnection();
+		}
+	}
+	if (thread_error) std::rethrow_exception(thread_error);
+	for (auto &error : errors)
+	{
+		if (error) std::rethrow_exception(error);
+	}
+}
+
 
-	putBack(get()); // Force Start MySQL Connection + Return MySQL Connection Back to Idle
+bool MariaDBPool::multiStatements()
+{
+	return login_data.options.connector.multi_statements;
+}
+
+
+void MariaDBPool::initConnector(MariaDBConnector &connector, const MariaDBConnector::options_struct &options)
+// Same Database login, different connection options i.e Test App connection benchmark
+{
+	connector.init(login_data.host, login_data.port, login_data.user, login_data.password, login_data.db, options);
+}
+
+
+const MariaDBConnector::options_struct &MariaDBPool::connectorOptions()
+{
+	return login_data.options.connector;
+}
+
+
+std::unique_ptr<MariaDBPool::mariadb_session_struct> MariaDBPool::connect()
+// New Connection, called without mariadb_session_pool_mutex held so a slow handshake only blocks its caller
+{
+	std::unique_ptr<mariadb_session_struct> mariadb_session(new mariadb_session_struct());
+	initConnector(mariadb_session->connector, login_data.options.connector);
+	mariadb_session->connector.connect();
+	mariadb_session->query.init(mariadb_session->connector);
+	mariadb_session->statements.setMaxSize(login_data.options.statement_cache);
+	mariadb_session->sql_statements.setMaxSize(login_data.options.sql_statement_cache);
+	return mariadb_session;
+}
+
+
+void MariaDBPool::releaseConnection()
+// Connection closed or failed to open, its slot goes to the oldest waiter if any
+{
+	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	if (!waiters.empty())
+	{
+		waiter_struct *waiter = waiters.front();
+		waiters.pop_front();
+		waiter->slot = true;
+		waiter->cv.notify_one();
+	}	else {
+		--num_connections;
+	}
+}
+
+
+void MariaDBPool::recordWait(const std::chrono::steady_clock::time_point &start)
+// Called with mariadb_session_pool_mutex held
+{
+	auto wait_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	int bucket = 0;
+	for (long long bound = 1; (bucket < (num_of_wait_buckets - 1)) && (wait_ms >= bound); bound *= 10)
+	{
+		++bucket;
+	}
+	++wait_histogram[bucket];
 }
 
 
 std::unique_ptr<MariaDBPool::mariadb_session_struct> MariaDBPool::get()
+// Throws extDB3Exception if no session is free within wait_timeout, MariaDBConnectorException if a new connection fails
 {
-	std::unique_ptr<mariadb_session_struct> mariadb_session;
+	auto start = std::chrono::steady_clock::now();
 	{
-		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+		std::unique_lock<std::mutex> lock(mariadb_session_pool_mutex);
 		if (mariadb_session_pool.size() > 0)
 		{
-			mariadb_session = std::move(mariadb_session_pool.front());
+			// Any waiters were handed sessions by putBack, so idle sessions are free to take
+			std::unique_ptr<mariadb_session_struct> mariadb_session = std::move(mariadb_session_pool.front());
 			mariadb_session_pool.pop_front();
-		} else {
-			mariadb_session.reset(new mariadb_session_struct());
-			mariadb_session->connector.init(login_data.host, login_data.port, login_data.user, login_data.password, login_data.db);
-			mariadb_session->connector.connect();
-			mariadb_session->query.init(mariadb_session->connector);
+			recordWait(start);
+			return mariadb_session;
+		}
+		if ((login_data.options.max_connections == 0) || (num_connections < login_data.options.max_connections))
+		{
+			++num_connections;
+			recordWait(start);
+		}	else {
+			waiter_struct waiter;
+			waiters.push_back(&waiter);
+			bool ready = waiter.cv.wait_until(lock, start + std::chrono::milliseconds(login_data.options.wait_timeout), [&waiter]
+			{
+				return (waiter.session || waiter.slot);
+			});
+			recordWait(start);
+			if (!ready)
+			{
+				waiters.remove(&waiter);
+				++wait_timeouts;
+				throw extDB3Exception("Database Pool Timeout, all " + std::to_string(login_data.options.max_connections) + " Connections in use");
+			}
+			if (waiter.session)
+			{
+				return std::move(waiter.session);
+			}
+			// Handed a connection slot
 		}
 	}
-	return mariadb_session;
+	try
+	{
+		return connect();
+	}
+	catch (...)
+	{
+		releaseConnection();
+		throw;
+	}
 }
 
 
@@ -59,37 +211,197 @@ void MariaDBPool::putBack(std::unique_ptr<mariadb_session_struct> mariadb_sessio
 	mariadb_session->last_used = boost::posix_time::second_clock::local_time();
 	{
 		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
-		mariadb_session_pool.push_back(std::move(mariadb_session));
+		if (!waiters.empty())
+		{
+			waiter_struct *waiter = waiters.front();
+			waiters.pop_front();
+			waiter->session = std::move(mariadb_session);
+			waiter->cv.notify_one();
+		}	else {
+			mariadb_session_pool.push_front(std::move(mariadb_session));
+		}
+	}
+}
+
+
+void MariaDBPool::returnChecked(std::unique_ptr<mariadb_session_struct> mariadb_session)
+// Back into Idle by last_used, a health check ping doesn't count as use
+{
+	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	if (!waiters.empty())
+	{
+		waiter_struct *waiter = waiters.front();
+		waiters.pop_front();
+		waiter->session = std::move(mariadb_session);
+		waiter->cv.notify_one();
+		return;
+	}
+	auto session_itr = mariadb_session_pool.begin();
+	while ((session_itr != mariadb_session_pool.end()) && ((*session_itr)->last_used > mariadb_session->last_used))
+	{
+		++session_itr;
+	}
+	mariadb_session_pool.insert(session_itr, std::move(mariadb_session));
+}
+
+
+void MariaDBPool::addReplica(std::unique_ptr<MariaDBPool> replica_pool)
+// Only during ADD_DATABASE, before any protocol uses the pool
+{
+	replica_pools.push_back(std::move(replica_pool));
+}
+
+
+MariaDBPool *MariaDBPool::replica()
+// Replica with the least sessions in use + waiting, skipping replicas that recently failed, nullptr if none
+//   Once a failed replica's backoff ends only one caller gets it as a probe, everyone else keeps skipping it until replicaRecovered
+{
+	MariaDBPool *selected_pool = nullptr;
+	unsigned int selected_outstanding = 0;
+	const long long now = std::chrono::steady_clock::now().time_since_epoch().count();
+	for (auto &replica_pool : replica_pools)
+	{
+		long long unavailable_until = replica_pool->replica_unavailable_until.load();
+		if (unavailable_until > now) continue;
+		if (unavailable_until != 0)
+		{
+			const long long probe_until = (std::chrono::steady_clock::now() + std::chrono::seconds(replica_retry_secs)).time_since_epoch().count();
+			if (replica_pool->replica_unavailable_until.compare_exchange_strong(unavailable_until, probe_until))
+			{
+				return replica_pool.get();
+			}
+			continue;
+		}
+		unsigned int replica_outstanding = replica_pool->outstanding();
+		if ((selected_pool == nullptr) || (replica_outstanding < selected_outstanding))
+		{
+			selected_pool = replica_pool.get();
+			selected_outstanding = replica_outstanding;
+		}
+	}
+	return selected_pool;
+}
+
+
+void MariaDBPool::replicaFailed()
+{
+	replica_unavailable_until = (std::chrono::steady_clock::now() + std::chrono::seconds(replica_retry_secs)).time_since_epoch().count();
+}
+
+
+void MariaDBPool::replicaRecovered()
+{
+	if (replica_unavailable_until.load() != 0)
+	{
+		replica_unavailable_until = 0;
 	}
 }
 
 
+unsigned int MariaDBPool::outstanding()
+{
+	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	return (num_connections - static_cast<unsigned int>(mariadb_session_pool.size())) + static_cast<unsigned int>(waiters.size());
+}
+
+
 void MariaDBPool::idleCleanup()
 {
 	auto tick = boost::posix_time::second_clock::local_time();
 	boost::posix_time::time_duration diff;
-	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	unsigned int missing_idle = 0;
 	{
-		// Remove old connections (10 Minutes)
-		for(auto session_itr = mariadb_session_pool.end(); session_itr != mariadb_session_pool.begin(); --session_itr) {
-			diff = tick - (*session_itr)->last_used;
-			if (diff.total_seconds() > 600)
-			{
-				mariadb_session_pool.erase(mariadb_session_pool.begin(), session_itr);
-				break;
-			};
+		std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+		// Remove old connections (10 Minutes), oldest are at the back
+		while (mariadb_session_pool.size() > login_data.options.min_idle)
+		{
+			diff = tick - mariadb_session_pool.back()->last_used;
+			if (diff.total_seconds() <= 600) break;
+			mariadb_session_pool.pop_back();
+			--num_connections;
+		}
+		// Top up Idle to min_idle, within max_connections
+		while ((mariadb_session_pool.size() + missing_idle) < login_data.options.min_idle)
+		{
+			if ((login_data.options.max_connections > 0) && (num_connections >= login_data.options.max_connections)) break;
+			++num_connections;
+			++missing_idle;
+		}
+	}
+	for (unsigned int i = 0; i < missing_idle; ++i)
+	{
+		try
+		{
+			putBack(connect());
 		}
-		// Ping any connections still alive, Reconnect & Wipe Statements if Required
-		for(auto session_itr = mariadb_session_pool.begin(); session_itr != mariadb_session_pool.end(); ++session_itr) {
-			auto original_thread_id = mysql_thread_id((*session_itr)->connector.mysql_ptr);
-			if (mysql_ping((*session_itr)->connector.mysql_ptr))
+		catch (MariaDBConnectorException &)
+		{
+			releaseConnection();
+		}
+	}
+	for (auto &replica_pool : replica_pools)
+	{
+		replica_pool->idleCleanup();
+	}
+}
+
+
+void MariaDBPool::healthCheck()
+// Pings sessions idle longer than health_check_interval, one at a time so get() only waits on the pool mutex, not the network
+//   Reconnected sessions lose their Prepared Statements, sessions that fail to reconnect are closed
+{
+	for (auto &replica_pool : replica_pools)
+	{
+		replica_pool->healthCheck();
+	}
+	if (login_data.options.health_check_interval <= 0) return;
+	auto tick = boost::posix_time::second_clock::local_time();
+	auto stale = tick - boost::posix_time::seconds(login_data.options.health_check_interval);
+	while (true)
+	{
+		std::unique_ptr<mariadb_session_struct> mariadb_session;
+		{
+			std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+			for (auto session_itr = mariadb_session_pool.begin(); session_itr != mariadb_session_pool.end(); ++session_itr)
 			{
-				if ((original_thread_id) != mysql_thread_id((*session_itr)->connector.mysql_ptr))
+				if (((*session_itr)->last_used < stale) && ((*session_itr)->last_checked.is_not_a_date_time() || ((*session_itr)->last_checked < tick)))
 				{
-					(*session_itr)->statements.clear();
-					mysql_reset_connection((*session_itr)->connector.mysql_ptr);
-				};
-			};
+					mariadb_session = std::move(*session_itr);
+					mariadb_session_pool.erase(session_itr);
+					break;
+				}
+			}
 		}
+		if (!mariadb_session) break;
+
+		mariadb_session->last_checked = tick;
+		if (mariadb_session->connector.ping() != 0)
+		{
+			mariadb_session.reset();
+			releaseConnection();
+			continue;
+		}
+		if (mariadb_session->connector.reconnected())
+		{
+			mariadb_session->statements.clear();
+			mariadb_session->sql_statements.clear();
+			mysql_reset_connection(mariadb_session->connector.mysql_ptr);
+		}
+		returnChecked(std::move(mariadb_session));
+	}
+}
+
+
+void MariaDBPool::getStats(std::string &result)
+// [1,[connections,idle,waiting,max connections,wait timeouts,[< 1ms,< 10ms,< 100ms,< 1s,>= 1s]]]
+{
+	std::lock_guard<std::mutex> lock(mariadb_session_pool_mutex);
+	result = "[1,[" + std::to_string(num_connections) + "," + std::to_string(mariadb_session_pool.size()) + "," + std::to_string(waiters.size()) + "," +
+		std::to_string(login_data.options.max_connections) + "," + std::to_string(wait_timeouts) + ",[";
+	for (int i = 0; i < num_of_wait_buckets; ++i)
+	{
+		if (i > 0) result += ",";
+		result += std::to_string(wait_histogram[i]);
 	}
+	result += "]]]";
 }
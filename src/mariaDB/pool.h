@@ -5,10 +5,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/asio.hpp>
 #include <mysql.h>
@@ -16,9 +21,13 @@
 #include "connector.h"
 #include "query.h"
 #include "statement.h"
+#include "statement_cache.h"
 
 
 class MariaDBPool
+// Connections to one Database, most recently used idle session is reused first so surplus connections age out
+//   Upto max_connections are opened, once reached get() waits FIFO for a session to be put back
+//   Read Replicas are pools of their own, owned by the primary's pool
 {
 public:
 	MariaDBPool();
@@ -27,17 +36,48 @@ public:
 	struct mariadb_session_struct
 	{
 		boost::posix_time::ptime last_used;
+		boost::posix_time::ptime last_checked; // Last healthCheck ping
 		MariaDBConnector connector;
 		MariaDBQuery     query;
-		std::unordered_map<std::string, std::vector<MariaDBStatement> > statements;
+		MariaDBStatementCache statements;     // SQL_CUSTOM Prepared Statements, by Call Name
+		MariaDBStatementCache sql_statements; // SQL Protocol BINARY mode, by SQL Query
 	};
 
-	void init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db);
+	struct options_struct
+	{
+		MariaDBConnector::options_struct connector;
+		std::size_t sql_statement_cache = 32;
+		std::size_t statement_cache = 64;
+		unsigned int min_connections = 1;  // Opened at init
+		unsigned int max_connections = 0;  // 0 == unlimited
+		unsigned int min_idle = 0;         // Kept open by idleCleanup
+		int wait_timeout = 5000;           // Milliseconds get() waits once max_connections are in use
+		int health_check_interval = 300;   // Seconds idle before healthCheck pings a session, 0 == never
+	};
+
+	void init(std::string &host, unsigned int &port, std::string &user, std::string &password, std::string &db, const options_struct &options);
+	bool multiStatements();
 	std::unique_ptr<mariadb_session_struct> get();
 	void putBack(std::unique_ptr<mariadb_session_struct> mariadb_session);
+	void releaseConnection();
 	void idleCleanup();
+	void healthCheck();
+	void getStats(std::string &result);
+	void initConnector(MariaDBConnector &connector, const MariaDBConnector::options_struct &options);
+	const MariaDBConnector::options_struct &connectorOptions();
+
+	// Read Replicas
+	void addReplica(std::unique_ptr<MariaDBPool> replica_pool);
+	MariaDBPool *replica();
+	void replicaFailed();
+	void replicaRecovered();
+	unsigned int outstanding();
 
 private:
+	std::unique_ptr<mariadb_session_struct> connect();
+	void returnChecked(std::unique_ptr<mariadb_session_struct> mariadb_session);
+	void recordWait(const std::chrono::steady_clock::time_point &start);
+
 	struct login_data_struct
 	{
 		std::string host;
@@ -45,9 +85,33 @@ private:
 		std::string password;
 		std::string db;
 		unsigned int port;
+		options_struct options;
 	};
 	login_data_struct login_data;
 
-	std::list<std::unique_ptr<mariadb_session_struct>> mariadb_session_pool;
+	std::list<std::unique_ptr<mariadb_session_struct>> mariadb_session_pool; // Front == most recently used
 	std::mutex mariadb_session_pool_mutex;
+
+	// Connections opened or being opened, idle + in use
+	unsigned int num_connections = 0;
+
+	// get() calls waiting on max_connections, oldest first
+	//   putBack hands its session straight to the front waiter, a failed connect hands over its slot instead
+	struct waiter_struct
+	{
+		std::condition_variable cv;
+		std::unique_ptr<mariadb_session_struct> session;
+		bool slot = false;
+	};
+	std::list<waiter_struct *> waiters;
+
+	// Time get() took to hand out a session, excluding opening a new connection
+	//   Buckets < 1ms, < 10ms, < 100ms, < 1s, >= 1s
+	static const int num_of_wait_buckets = 5;
+	unsigned long long wait_histogram[num_of_wait_buckets];
+	unsigned long long wait_timeouts = 0;
+
+	std::vector<std::unique_ptr<MariaDBPool>> replica_pools;
+	std::atomic<long long> replica_unavailable_until; // steady_clock ticks, replica skipped until then after a failure
+	static const int replica_retry_secs = 10;
 };
@@ -5,21 +5,28 @@
 
 #include "query.h"
 
-#include <iomanip>
-#include <iostream>
-#include <sstream>
+#include <memory>
 
 #include <errmsg.h>
 
+#include "datetime.h"
 #include "exceptions.h"
-#include "../md5/md5.h"
+
+
+namespace
+{
+	struct result_deleter
+	{
+		void operator()(MYSQL_RES *result) const
+		{
+			mysql_free_result(result);
+		}
+	};
+}
 
 
 MariaDBQuery::MariaDBQuery()
 {
-	loc_date = std::locale(std::locale::classic(), new boost::posix_time::time_input_facet("%Y-%m-%d"));
-	loc_datetime = std::locale(std::locale::classic(), new boost::posix_time::time_input_facet("%Y-%m-%d %H:%M:%S"));
-	loc_time = std::locale(std::locale::classic(), new boost::posix_time::time_input_facet("%H:%M:%S"));
 }
 
 
@@ -34,16 +41,21 @@ void MariaDBQuery::init(MariaDBConnector &connector)
 }
 
 
-void MariaDBQuery::get(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &result_vec)
+void MariaDBQuery::get(const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, std::string &insertID, MariaDBRowSink &sink, const bool stream_results)
+// stream_results, rows are fetched unbuffered (mysql_use_result) + handed to the sink as they arrive
 {
-	result_vec.clear();
+	sink.clear();
+	int next_result;
 	do {
-		MYSQL_RES *result = (mysql_store_result(connector_ptr->mysql_ptr));  // Returns NULL for Errors & No Result
-		insertID = std::to_string(mysql_insert_id(connector_ptr->mysql_ptr));
+		MYSQL_RES *result = stream_results ? mysql_use_result(connector_ptr->mysql_ptr) : mysql_store_result(connector_ptr->mysql_ptr);  // Returns NULL for Errors & No Result
+		std::unique_ptr<MYSQL_RES, result_deleter> result_guard(result); // Unbuffered rows are read + discarded on free, keeps connection in sync if an exception is thrown
+		if (mysql_insert_id(connector_ptr->mysql_ptr) != 0) // Multi Statements, keep last insert id i.e COMMIT
+		{
+			insertID = std::to_string(mysql_insert_id(connector_ptr->mysql_ptr));
+		}
 		if (!result)
 		{
 			std::string error_msg(mysql_error(connector_ptr->mysql_ptr));
-			mysql_free_result(result);
 			if (!error_msg.empty())
 			{
 				throw MariaDBQueryException(connector_ptr->mysql_ptr);
@@ -55,200 +67,95 @@ void MariaDBQuery::get(std::vector<sql_option> &output_options, std::string &str
 				MYSQL_ROW row;
 				MYSQL_FIELD *fields;
 				fields = mysql_fetch_fields(result);
-				output_options.resize(num_fields);
+				sink.reserve(fields, num_fields, mysql_num_rows(result));
 
 				while ((row = mysql_fetch_row(result)) != NULL)
 				{
-					std::vector<std::string> field_row;
+					unsigned long *lengths = mysql_fetch_lengths(result);
+					sink.beginRow();
 					for (unsigned int i = 0; i < num_fields; i++)
 					{
+						const MariaDBTransform &transform = (i < output_transforms.size()) ? output_transforms[i] : MariaDBTransform::none;
+						if (!(row[i]))
+						{
+							transform.applyNull(sink.beginField());
+							sink.endField();
+							continue;
+						}
 						switch (fields[i].type)
 						{
 							case MYSQL_TYPE_DATE:
 							{
-								try
-								{
-									std::istringstream is(row[i]);
-									is.imbue(loc_date);
-									boost::posix_time::ptime ptime;
-									is >> ptime;
-
-									std::stringstream stream;
-									facet = new boost::posix_time::time_facet();
-									facet->format("[%Y,%m,%d]");
-									stream.imbue(std::locale(std::locale::classic(), facet));
-									stream << ptime;
-									std::string tmp_str = stream.str();
-									if (tmp_str != "not-a-date-time")
-									{
-										field_row.push_back(std::move(tmp_str));
-									} else {
-										field_row.emplace_back("[]");
-									}
-								}
-								catch(std::exception& e)
-								{
-									field_row.emplace_back("[]");
-								}
+								MariaDBDateTime::convert(row[i], lengths[i], MariaDBDateTime::DATE, sink.beginField());
+								sink.endField();
 								break;
 							}
 							case MYSQL_TYPE_DATETIME:
 							{
-								try
-								{
-									std::istringstream is(row[i]);
-									is.imbue(loc_datetime);
-									boost::posix_time::ptime ptime;
-									is >> ptime;
-
-									std::stringstream stream;
-									facet = new boost::posix_time::time_facet();
-									facet->format("[%Y,%m,%d,%H,%M,%S]");
-									stream.imbue(std::locale(std::locale::classic(), facet));
-									stream << ptime;
-									std::string tmp_str = stream.str();
-									if (tmp_str != "not-a-date-time")
-									{
-										field_row.push_back(std::move(tmp_str));
-									} else {
-										field_row.emplace_back("[]");
-									}
-								}
-								catch(std::exception& e)
-								{
-									field_row.emplace_back("[]");
-								}
+								MariaDBDateTime::convert(row[i], lengths[i], MariaDBDateTime::DATETIME, sink.beginField());
+								sink.endField();
 								break;
 							}
 							case MYSQL_TYPE_TIME:
 							{
-								try
-								{
-									std::istringstream is(row[i]);
-									is.imbue(loc_time);
-									boost::posix_time::ptime ptime;
-									is >> ptime;
-
-									std::stringstream stream;
-									facet = new boost::posix_time::time_facet();
-									facet->format("[%H,%M,%S]");
-									stream.imbue(std::locale(std::locale::classic(), facet));
-									stream << ptime;
-									std::string tmp_str = stream.str();
-									if (tmp_str != "not-a-date-time")
-									{
-										field_row.push_back(std::move(tmp_str));
-									} else {
-										field_row.emplace_back("[]");
-									}
-								}
-								catch(std::exception& e)
-								{
-									field_row.emplace_back("[]");
-								}
+								MariaDBDateTime::convert(row[i], lengths[i], MariaDBDateTime::TIME, sink.beginField());
+								sink.endField();
 								break;
 							}
 							case MYSQL_TYPE_NULL:
 							{
-								if (output_options[i].nullConvert)
-								{
-									field_row.emplace_back("objNull");
-								} else {
-									field_row.emplace_back("\"\"");
-								}
+								transform.applyNull(sink.beginField());
+								sink.endField();
 								break;
 							}
 							default:
 							{
-								std::string tmp_str(row[i]);
-
-								if (output_options[i].strip)
+								if (transform.empty())
 								{
-									std::string stripped_str(tmp_str);
-									for (auto &strip_char : strip_chars)
-									{
-										boost::erase_all(stripped_str, std::string(1, strip_char));
-									}
-									if (stripped_str != tmp_str)
-									{
-										switch (strip_chars_mode)
-										{
-											case 2: // Log + Error
-												throw extDB3Exception("Bad Character detected from database query");
-											//case 1: // Log
-												//logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-										}
-										tmp_str = std::move(stripped_str);
-									}
-								}
-								if (output_options[i].beguidConvert)
-								{
-									try
-									{
-										int64_t steamID = std::stoll(tmp_str, nullptr);
-										std::stringstream bestring;
-										int8_t i = 0, parts[8] = { 0 };
-										do parts[i++] = steamID & 0xFF;
-										while (steamID >>= 8);
-										bestring << "BE";
-										for (int i = 0; i < sizeof(parts); i++) {
-											bestring << char(parts[i]);
-										}
-										tmp_str = md5(bestring.str());
-									}
-									catch(std::exception const & e)
+									sink.addField(row[i], lengths[i]);
+								}	else {
+									bool clean = transform.apply(row[i], lengths[i], sink.beginField());
+									sink.endField();
+									if ((!clean) && (strip_chars_mode == 2)) // Log + Error
 									{
-										tmp_str = "ERROR";
+										throw extDB3Exception("Bad Character detected from database query");
 									}
 								}
-								if (output_options[i].boolConvert)
-								{
-									if (tmp_str == "1")
-									{
-										tmp_str = "true";
-									} else {
-										tmp_str = "false";
-									}
-								}
-								if (output_options[i].string_remove_escape_quotes)
-								{
-									boost::replace_all(tmp_str, "\"\"", "\"");
-								}
-								if (output_options[i].string_add_escape_quotes)
-								{
-									boost::replace_all(tmp_str, "\"", "\"\"");
-								}
-								if (output_options[i].stringify)
-								{
-									tmp_str = "\"" + tmp_str + "\"";
-								}
-								if (output_options[i].stringify2)
-								{
-									tmp_str = "'" + tmp_str + "'";
-								}
-								field_row.push_back(std::move(tmp_str));
 							}
 						}
 					}
-					result_vec.push_back(std::move(field_row));
+					sink.endRow();
+				}
+				if (stream_results && (mysql_errno(connector_ptr->mysql_ptr) != 0))
+				{
+					// Unbuffered fetch failed i.e connection lost mid result
+					throw MariaDBQueryException(connector_ptr->mysql_ptr);
 				}
 			}
-			mysql_free_result(result);
 		}
-	} while ((mysql_next_result(connector_ptr->mysql_ptr)) == 0);
+	} while ((next_result = mysql_next_result(connector_ptr->mysql_ptr)) == 0);
+	if (next_result > 0)
+	{
+		// Multi Statements, a later statement failed
+		throw MariaDBQueryException(connector_ptr->mysql_ptr);
+	}
 }
 
 
-void MariaDBQuery::get(int &check_dataType_string, bool &check_dataType_null, std::string &insertID, std::vector<std::vector<std::string>> &result_vec)
+void MariaDBQuery::get(int &check_dataType_string, bool &check_dataType_null, std::string &insertID, MariaDBRowSink &sink, const bool stream_results)
 {
-	result_vec.clear();
+	sink.clear();
+	int next_result;
 	do {
-		MYSQL_RES *result = (mysql_store_result(connector_ptr->mysql_ptr));  // Returns NULL for Errors & No Result
-		insertID = std::to_string(mysql_insert_id(connector_ptr->mysql_ptr));
+		MYSQL_RES *result = stream_results ? mysql_use_result(connector_ptr->mysql_ptr) : mysql_store_result(connector_ptr->mysql_ptr);  // Returns NULL for Errors & No Result
+		std::unique_ptr<MYSQL_RES, result_deleter> result_guard(result); // Unbuffered rows are read + discarded on free, keeps connection in sync if an exception is thrown
+		if (mysql_insert_id(connector_ptr->mysql_ptr) != 0) // Multi Statements, keep last insert id i.e COMMIT
+		{
+			insertID = std::to_string(mysql_insert_id(connector_ptr->mysql_ptr));
+		}
 		if (!result)
 		{
 			std::string error_msg(mysql_error(connector_ptr->mysql_ptr));
-			mysql_free_result(result);
 			if (!error_msg.empty())
 			{
 				throw MariaDBQueryException(connector_ptr->mysql_ptr);
@@ -260,44 +167,48 @@ void MariaDBQuery::get(int &check_dataType_string, bool &check_dataType_null, st
 				MYSQL_ROW row;
 				MYSQL_FIELD *fields;
 				fields = mysql_fetch_fields(result);
+				sink.reserve(fields, num_fields, mysql_num_rows(result));
+
 				while ((row = mysql_fetch_row(result)) != NULL)
 				{
-					std::vector<std::string> field_row;
+					unsigned long *lengths = mysql_fetch_lengths(result);
+					sink.beginRow();
 					for (unsigned int i = 0; i < num_fields; i++)
 					{
 						if (!(row[i]))
 						{
 							if (check_dataType_null)
 							{
-								field_row.emplace_back("objNull");
+								sink.addField("objNull");
 							} else {
-								field_row.emplace_back("\"\"");
+								sink.addField("\"\"");
 							}
 						} else {
 							switch(fields[i].type)
 							{
 								case MYSQL_TYPE_VAR_STRING:
 								{
-									std::string tmp_str(row[i]);
-									if (tmp_str.empty())
+									if (lengths[i] == 0)
 									{
 										if (check_dataType_null)
 										{
-											field_row.emplace_back("objNull");
+											sink.addField("objNull");
 										} else {
-											field_row.emplace_back("\"\"");
+											sink.addField("\"\"");
 										}
 									} else {
 										switch (check_dataType_string)
 										{
 											case 1:
-												field_row.emplace_back(('"' + std::move(tmp_str) + '"'));
+												sink.beginField().append(1, '"').append(row[i], lengths[i]).append(1, '"');
+												sink.endField();
 												break;
 											case 2:
-												field_row.emplace_back(('\'' + std::move(tmp_str) + '\''));
+												sink.beginField().append(1, '\'').append(row[i], lengths[i]).append(1, '\'');
+												sink.endField();
 												break;
 											default:
-												field_row.push_back(std::move(tmp_str));
+												sink.addField(row[i], lengths[i]);
 										}
 									}
 									break;
@@ -306,128 +217,70 @@ void MariaDBQuery::get(int &check_dataType_string, bool &check_dataType_null, st
 								case MYSQL_TYPE_MEDIUM_BLOB:
 								case MYSQL_TYPE_BLOB:
 								{
-									std::string tmp_str(row[i]);
-									if (tmp_str.empty())
+									if (lengths[i] == 0)
 									{
 										if (check_dataType_null)
 										{
-											field_row.emplace_back("objNull");
+											sink.addField("objNull");
 										} else {
-											field_row.emplace_back("\"\"");
+											sink.addField("\"\"");
 										}
 									} else {
-										field_row.push_back(std::move(tmp_str));
+										sink.addField(row[i], lengths[i]);
 									}
 									break;
 								}
 								case MYSQL_TYPE_DATE:
 								{
-									try
-									{
-										std::istringstream is(row[i]);
-										is.imbue(loc_date);
-										boost::posix_time::ptime ptime;
-										is >> ptime;
-
-										std::stringstream stream;
-										facet = new boost::posix_time::time_facet();
-										facet->format("[%Y,%m,%d]");
-										stream.imbue(std::locale(std::locale::classic(), facet));
-										stream << ptime;
-										std::string tmp_str = stream.str();
-										if (tmp_str != "not-a-date-time")
-										{
-											field_row.push_back(std::move(tmp_str));
-										} else {
-											field_row.emplace_back("[]");
-										}
-									}
-									catch(std::exception& e)
-									{
-										field_row.emplace_back("[]");
-									}
+									MariaDBDateTime::convert(row[i], lengths[i], MariaDBDateTime::DATE, sink.beginField());
+									sink.endField();
 									break;
 								}
 								case MYSQL_TYPE_TIMESTAMP:
 								case MYSQL_TYPE_DATETIME:
 								{
-									try
-									{
-										std::istringstream is(row[i]);
-										is.imbue(loc_datetime);
-										boost::posix_time::ptime ptime;
-										is >> ptime;
-
-										std::stringstream stream;
-										facet = new boost::posix_time::time_facet();
-										facet->format("[%Y,%m,%d,%H,%M,%S]");
-										stream.imbue(std::locale(std::locale::classic(), facet));
-										stream << ptime;
-										std::string tmp_str = stream.str();
-										if (tmp_str != "not-a-date-time")
-										{
-											field_row.push_back(std::move(tmp_str));
-										} else {
-											field_row.emplace_back("[]");
-										}
-									}
-									catch(std::exception& e)
-									{
-										field_row.emplace_back("[]");
-									}
+									MariaDBDateTime::convert(row[i], lengths[i], MariaDBDateTime::DATETIME, sink.beginField());
+									sink.endField();
 									break;
 								}
 								case MYSQL_TYPE_TIME:
 								{
-									try
-									{
-										std::istringstream is(row[i]);
-										is.imbue(loc_time);
-										boost::posix_time::ptime ptime;
-										is >> ptime;
-
-										std::stringstream stream;
-										facet = new boost::posix_time::time_facet();
-										facet->format("[%H,%M,%S]");
-										stream.imbue(std::locale(std::locale::classic(), facet));
-										stream << ptime;
-										std::string tmp_str = stream.str();
-										if (tmp_str != "not-a-date-time")
-										{
-											field_row.push_back(std::move(tmp_str));
-										} else {
-											field_row.emplace_back("[]");
-										}
-									}
-									catch(std::exception& e)
-									{
-										field_row.emplace_back("[]");
-									}
+									MariaDBDateTime::convert(row[i], lengths[i], MariaDBDateTime::TIME, sink.beginField());
+									sink.endField();
 									break;
 								}
 								case MYSQL_TYPE_NULL:
 								{
 									if (check_dataType_null)
 									{
-										field_row.emplace_back("objNull");
+										sink.addField("objNull");
 									} else {
-										field_row.emplace_back("\"\"");
+										sink.addField("\"\"");
 									}
 									break;
 								}
 								default:
 								{
-									field_row.emplace_back(row[i]);
+									sink.addField(row[i], lengths[i]);
 								}
 							}
 						}
 					}
-					result_vec.push_back(std::move(field_row));
+					sink.endRow();
+				}
+				if (stream_results && (mysql_errno(connector_ptr->mysql_ptr) != 0))
+				{
+					// Unbuffered fetch failed i.e connection lost mid result
+					throw MariaDBQueryException(connector_ptr->mysql_ptr);
 				}
 			}
-			mysql_free_result(result);
 		}
-	} while ((mysql_next_result(connector_ptr->mysql_ptr)) == 0);
+	} while ((next_result = mysql_next_result(connector_ptr->mysql_ptr)) == 0);
+	if (next_result > 0)
+	{
+		// Multi Statements, a later statement failed
+		throw MariaDBQueryException(connector_ptr->mysql_ptr);
+	}
 }
 
 
@@ -8,11 +8,12 @@
 #include <string>
 #include <vector>
 
-#include <boost/date_time/posix_time/posix_time.hpp>
 #include <mysql.h>
 
 #include "abstract.h"
 #include "connector.h"
+#include "row_sink.h"
+#include "transform.h"
 
 
 class MariaDBQuery
@@ -23,13 +24,9 @@ public:
 
 	void init(MariaDBConnector &connector);
 	void send(std::string &sql_query);
-	void get(int &check_dataType_string, bool &check_dataType_null, std::string &insertID, std::vector<std::vector<std::string>> &result_vec);
-	void get(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &result_vec);
+	void get(int &check_dataType_string, bool &check_dataType_null, std::string &insertID, MariaDBRowSink &sink, const bool stream_results=false);
+	void get(const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, std::string &insertID, MariaDBRowSink &sink, const bool stream_results=false);
 
 private:
 	MariaDBConnector *connector_ptr;
-	std::locale loc_date;
-	std::locale loc_datetime;
-	std::locale loc_time;
-	boost::posix_time::time_facet* facet;
 };
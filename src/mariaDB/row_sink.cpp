@@ -0,0 +1,126 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "row_sink.h"
+
+#include <algorithm>
+
+
+void MariaDBRowSink::reserve(const MYSQL_FIELD *fields, unsigned int num_fields, unsigned long long num_rows)
+// Size estimate for a buffered result, max_length is only known for some results
+{
+	std::size_t row_size = 3;
+	for (unsigned int i = 0; i < num_fields; ++i)
+	{
+		row_size += std::max<std::size_t>(fields[i].max_length, 8) + 1;
+	}
+	reserve(row_size * num_rows);
+}
+
+
+void MariaDBRowSink::addField(const char *value, std::size_t length)
+{
+	beginField().append(value, length);
+	endField();
+}
+
+
+void MariaDBRowSink::addField(const char *value)
+{
+	beginField().append(value);
+	endField();
+}
+
+
+void MariaDBRowSink::addField(const std::string &value)
+{
+	beginField().append(value);
+	endField();
+}
+
+
+MariaDBSQFRowSink::MariaDBSQFRowSink(std::string &output) : output(output)
+{
+	start = output.size();
+}
+
+
+void MariaDBSQFRowSink::reserve(std::size_t size)
+{
+	output.reserve(output.size() + size);
+}
+
+
+void MariaDBSQFRowSink::clear()
+{
+	output.resize(start);
+	num_rows = 0;
+}
+
+
+void MariaDBSQFRowSink::beginRow()
+{
+	if (num_rows > 0)
+	{
+		output += ',';
+	}
+	output += '[';
+	num_fields = 0;
+}
+
+
+void MariaDBSQFRowSink::endRow()
+{
+	output += ']';
+	++num_rows;
+	if (flush && (output.size() >= flush_size))
+	{
+		flush(output);
+		output.clear();
+		start = 0;
+		is_streamed = true;
+	}
+}
+
+
+std::string &MariaDBSQFRowSink::beginField()
+{
+	if (num_fields > 0)
+	{
+		output += ',';
+	}
+	++num_fields;
+	field_start = output.size();
+	return output;
+}
+
+
+void MariaDBSQFRowSink::endField()
+{
+	if (output.size() == field_start)
+	{
+		output += "\"\"";
+	}
+}
+
+
+std::size_t MariaDBSQFRowSink::rows() const
+{
+	return num_rows;
+}
+
+
+void MariaDBSQFRowSink::stream(std::function<void(std::string &)> flush, std::size_t flush_size)
+{
+	this->flush = flush;
+	this->flush_size = flush_size;
+}
+
+
+bool MariaDBSQFRowSink::streamed() const
+// Rows already handed to flush can't be cleared anymore
+{
+	return is_streamed;
+}
@@ -0,0 +1,69 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include <mysql.h>
+
+
+class MariaDBRowSink
+// Receives result rows as MariaDBQuery::get / MariaDBStatement::execute fetch them
+//   Field text is appended straight into the buffer returned by beginField
+{
+public:
+	virtual ~MariaDBRowSink() {}
+
+	virtual void reserve(std::size_t /*size*/) {}
+	void reserve(const MYSQL_FIELD *fields, unsigned int num_fields, unsigned long long num_rows);
+	virtual void clear() = 0;
+
+	virtual void beginRow() = 0;
+	virtual void endRow() = 0;
+	virtual std::string &beginField() = 0;
+	virtual void endField() = 0;
+
+	void addField(const char *value, std::size_t length);
+	void addField(const char *value);
+	void addField(const std::string &value);
+};
+
+
+class MariaDBSQFRowSink: public MariaDBRowSink
+// Writes rows as SQF Array text i.e [1,"abc"],[2,"def"] into output, starting at its current size
+//   Empty fields are written as ""
+//   Streaming, output is handed to flush + cleared after a row once it reaches flush_size
+{
+public:
+	MariaDBSQFRowSink(std::string &output);
+
+	using MariaDBRowSink::reserve;
+	void reserve(std::size_t size);
+	void clear();
+
+	void beginRow();
+	void endRow();
+	std::string &beginField();
+	void endField();
+
+	std::size_t rows() const;
+
+	void stream(std::function<void(std::string &)> flush, std::size_t flush_size);
+	bool streamed() const;
+
+private:
+	std::string &output;
+	std::size_t start;
+
+	std::function<void(std::string &)> flush;
+	std::size_t flush_size = 0;
+	bool is_streamed = false;
+
+	std::size_t field_start = 0;
+	std::size_t num_rows = 0;
+	unsigned int num_fields = 0;
+};
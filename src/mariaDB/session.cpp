@@ -5,9 +5,35 @@
 
 #include "session.h"
 
+#include "exceptions.h"
 
-MariaDBSession::MariaDBSession(MariaDBPool *database_pool)
+
+MariaDBSession::MariaDBSession(MariaDBPool *database_pool, const bool read_only)
+// read_only, session from a Read Replica if the database has any, primary if none are available
 {
+	if (read_only)
+	{
+		MariaDBPool *replica_pool = database_pool->replica();
+		if (replica_pool != nullptr)
+		{
+			try
+			{
+				data = replica_pool->get();
+				replica_pool->replicaRecovered();
+				database_pool_ptr = replica_pool;
+				primary_pool_ptr = database_pool;
+				return;
+			}
+			catch (MariaDBConnectorException &)
+			{
+				replica_pool->replicaFailed();
+			}
+			catch (extDB3Exception &)
+			{
+				replica_pool->replicaFailed(); // Max Connections Wait timed out
+			}
+		}
+	}
 	database_pool_ptr = database_pool;
 	data = database_pool->get();
 }
@@ -20,5 +46,35 @@ MariaDBSession::~MariaDBSession(void)
 void MariaDBSession::resetSession()
 {
 	data->statements.clear();
+	data->sql_statements.clear();
 	mysql_reset_connection(data->connector.mysql_ptr);
 }
+
+void MariaDBSession::resetStatements(const std::string &callname)
+// Error in a SQL_CUSTOM Call, only its Prepared Statements are closed unless the connection itself was lost
+{
+	if (data->connector.reconnected())
+	{
+		resetSession();
+	}	else {
+		data->statements.erase(callname);
+	}
+}
+
+bool MariaDBSession::replicaLost()
+{
+	return ((primary_pool_ptr != nullptr) && data->connector.connectionLost());
+}
+
+void MariaDBSession::fallbackToPrimary()
+// Read Replica went away mid call, marks it failed & swaps to a primary session so the call can be redone
+{
+	database_pool_ptr->replicaFailed();
+	std::unique_ptr<MariaDBPool::mariadb_session_struct> primary_data = primary_pool_ptr->get(); // Throws, replica session still held
+	// Lost connection is closed not put back, otherwise LIFO reuse hands it to the next probe
+	data.reset();
+	database_pool_ptr->releaseConnection();
+	data = std::move(primary_data);
+	database_pool_ptr = primary_pool_ptr;
+	primary_pool_ptr = nullptr;
+}
@@ -11,12 +11,16 @@
 class MariaDBSession
 {
 public:
-	MariaDBSession(MariaDBPool *database_pool);
+	MariaDBSession(MariaDBPool *database_pool, const bool read_only=false);
 	~MariaDBSession();
 
 	std::unique_ptr<MariaDBPool::mariadb_session_struct> data;
 
 	void resetSession();
+	void resetStatements(const std::string &callname);
+	bool replicaLost();
+	void fallbackToPrimary();
 private:
 	MariaDBPool *database_pool_ptr;
+	MariaDBPool *primary_pool_ptr = nullptr; // Only set when the session is from a Read Replica
 };
@@ -5,14 +5,14 @@
 
 #include "statement.h"
 
+#include <cstdio>
+#include <cstring>
 #include <string>
-#include <sstream>
 
-#include <boost/algorithm/string.hpp>
 #include <errmsg.h>
 
+#include "datetime.h"
 #include "exceptions.h"
-#include "../md5/md5.h"
 
 
 MariaDBStatement::MariaDBStatement()
@@ -22,20 +22,11 @@ MariaDBStatement::MariaDBStatement()
 
 MariaDBStatement::~MariaDBStatement(void)
 {
-	if (mysql_stmt_result_metadata_ptr)
-	{
-		mysql_free_result(mysql_stmt_result_metadata_ptr);
-		mysql_stmt_result_metadata_ptr = NULL;
-	}
 	if (mysql_stmt_ptr)
 	{
 		mysql_stmt_close(mysql_stmt_ptr);
 	}
 	bind_data.clear();
-	if (mysql_bind_params)
-	{
-		delete[] mysql_bind_params;
-	}
 }
 
 
@@ -55,7 +46,9 @@ void MariaDBStatement::create()
 }
 
 
-void MariaDBStatement::prepare(std::string &sql_query)
+void MariaDBStatement::prepare(std::string &sql_query, std::shared_ptr<const layout_struct> shared_layout)
+// shared_layout, layout from an earlier prepare of the same SQL on another connection
+//   Only reused if the server agrees on param count + field types / lengths, otherwise result metadata is copied again
 {
 	if (!prepared)
 	{
@@ -71,32 +64,109 @@ void MariaDBStatement::prepare(std::string &sql_query)
 			if (return_code != 0) throw MariaDBStatementException0(connector_ptr->mysql_ptr);
 		}
 		prepared = true;
+		if ((shared_layout) &&
+			(shared_layout->param_count == mysql_stmt_param_count(mysql_stmt_ptr)) &&
+			(layoutMatches(*shared_layout)))
+		{
+			layout = shared_layout;
+		}	else {
+			loadLayout();
+		}
+		bindResult();
 	}
 }
 
 
+std::shared_ptr<const MariaDBStatement::layout_struct> MariaDBStatement::getLayout() const
+{
+	return layout;
+}
+
+
 unsigned long MariaDBStatement::getParamsCount()
 {
-	return mysql_stmt_param_count(mysql_stmt_ptr);
+	return layout->param_count;
+}
+
+
+void MariaDBStatement::bindTime(MariaDBStatement::mysql_bind_param &param)
+// Parses SQF Time Array [year,month,day,hour,minute,second] into param.time_buffer, no allocations unless invalid
+{
+	std::memset(&param.time_buffer, 0, sizeof(MYSQL_TIME));
+	if (param.buffer.size() <= 2)
+	{
+		throw extDB3Exception("Invalid Time Format3: " + param.buffer);
+	}
+
+	unsigned int *time_values[6] = {
+		&param.time_buffer.year, &param.time_buffer.month, &param.time_buffer.day,
+		&param.time_buffer.hour, &param.time_buffer.minute, &param.time_buffer.second
+	};
+	const char *pos = param.buffer.data() + 1; // Skip [
+	const char *end = param.buffer.data() + param.buffer.size() - 1; // Skip ]
+	for (int i = 0; ; ++i)
+	{
+		if (i == 6)
+		{
+			throw extDB3Exception("Invalid Time Format1: " + param.buffer);
+		}
+		while ((pos < end) && (*pos == ' ')) ++pos;
+		if ((pos == end) || (*pos < '0') || (*pos > '9'))
+		{
+			throw extDB3Exception("Invalid Time Format2: " + param.buffer);
+		}
+		unsigned long long time_value = 0;
+		while ((pos < end) && (*pos >= '0') && (*pos <= '9'))
+		{
+			time_value = (time_value * 10) + (*pos - '0');
+			if (time_value > 0xFFFFFFFF)
+			{
+				throw extDB3Exception("Invalid Time Format2: " + param.buffer);
+			}
+			++pos;
+		}
+		if ((pos < end) && (*pos == '.'))
+		{
+			// SQF Number with Fraction, ignored
+			++pos;
+			while ((pos < end) && (*pos >= '0') && (*pos <= '9')) ++pos;
+		}
+		*time_values[i] = static_cast<unsigned int>(time_value);
+		while ((pos < end) && (*pos == ' ')) ++pos;
+		if (pos == end) break;
+		if (*pos != ',')
+		{
+			throw extDB3Exception("Invalid Time Format2: " + param.buffer);
+		}
+		++pos;
+	}
 }
 
 
 void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param> &params)
+// Binds directly against params buffers, params must stay unchanged until execute has finished
+//   MYSQL_BIND array is kept per statement, only buffer pointers + lengths are updated each call
 {
-	int params_count = mysql_stmt_param_count(mysql_stmt_ptr); // mysql_stmt_ptr->param_count;
+	unsigned long params_count = mysql_stmt_param_count(mysql_stmt_ptr); // mysql_stmt_ptr->param_count;
 
 	if (params.size() != params_count)
 	{
 		throw extDB3Exception("SQL Invalid Number of Inputs Got " + std::to_string(params.size()) + " Expected " + std::to_string(params_count));
 	}
+	if (params_count == 0)
+	{
+		return;
+	}
 
-	delete[] mysql_bind_params;
-	mysql_bind_params = new MYSQL_BIND[params_count];
-	//memset(&mysql_bind_params, 0, sizeof(&mysql_bind_params));
+	if (mysql_bind_params.size() != params_count)
+	{
+		mysql_bind_params.resize(params_count);
+		std::memset(mysql_bind_params.data(), 0, sizeof(MYSQL_BIND) * params_count);
+	}
 
-	for (int i=0 ; i<params_count ; i++)
+	for (unsigned long i = 0; i < params_count; ++i)
 	{
-		MYSQL_BIND mysql_bind = {0};
+		MYSQL_BIND &mysql_bind = mysql_bind_params[i];
 		MariaDBStatement::mysql_bind_param &param = params[i];
 
 		switch (param.type)
@@ -105,73 +175,27 @@ void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param
 			case MYSQL_TYPE_TIME:
 			case MYSQL_TYPE_DATETIME:
 			{
-				/*
-				unsigned int year	The year
-				unsigned int month	The month of the year
-				unsigned int day	The day of the month
-				unsigned int hour	The hour of the day
-				unsigned int minute	The minute of the hour
-				unsigned int second	The second of the minute
-				my_bool neg	A boolean flag indicating whether the time is negative
-				unsigned long second_part	The fractional part of the second in microseconds
-				*/
-				if (param.buffer.size() > 2)
-				{
-					param.buffer.erase(0,1);
-					param.buffer.pop_back();
+				bindTime(param);
+				mysql_bind.buffer_type = param.type;
+				mysql_bind.buffer = &(param.time_buffer);
+				mysql_bind.buffer_length = sizeof(MYSQL_TIME);
+				break;
+			}
 
-					std::vector<std::string> tokens;
-					boost::split(tokens, param.buffer, boost::is_any_of(","));
-					unsigned int time_value;
-					for (unsigned int i = 0; i < tokens.size(); i++)
-					{
-						try
-						{
-							time_value = std::stoul(tokens[i]);
-							switch (i)
-							{
-								case 0:
-									param.time_buffer.year = time_value;
-									break;
-								case 1:
-									param.time_buffer.month = time_value;
-									break;
-								case 2:
-									param.time_buffer.day = time_value;
-									break;
-								case 3:
-									param.time_buffer.hour = time_value;
-									break;
-								case 4:
-									param.time_buffer.minute = time_value;
-									break;
-								case 5:
-									param.time_buffer.second = time_value;
-									break;
-								default:
-									throw extDB3Exception("Invalid Time Format1: [" + param.buffer + "]");
-								}
-						}
-						catch(std::exception const &e)
-						{
-							throw extDB3Exception("Invalid Time Format2: [" + param.buffer + "]");
-						}
-					}
-				} else {
-					throw extDB3Exception("Invalid Time Format3: " + param.buffer);
-				}
+			case MYSQL_TYPE_LONG:
+			case MYSQL_TYPE_LONGLONG:
+			case MYSQL_TYPE_DOUBLE:
+			{
 				mysql_bind.buffer_type = param.type;
-				mysql_bind.buffer = (char *)&(param.time_buffer);
+				mysql_bind.buffer = &(param.number_buffer);
+				mysql_bind.buffer_length = 0;
 				break;
 			}
 
 			case MYSQL_TYPE_TINY:
 			case MYSQL_TYPE_SHORT:
 			case MYSQL_TYPE_INT24:
-			case MYSQL_TYPE_LONG:
 			case MYSQL_TYPE_FLOAT:
-			case MYSQL_TYPE_DOUBLE:
-			case MYSQL_TYPE_LONGLONG:
 			case MYSQL_TYPE_DECIMAL:
 			case MYSQL_TYPE_NEWDECIMAL:
 			case MYSQL_TYPE_STRING:
@@ -182,15 +206,14 @@ void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param
 			case MYSQL_TYPE_BLOB:
 			{
 				mysql_bind.buffer_type = MYSQL_TYPE_STRING;
-				param.buffer_c.reset(new char[param.length+1]);
-				std::copy(param.buffer.begin(), param.buffer.end(), param.buffer_c.get());
-				mysql_bind.buffer  = param.buffer_c.get();
-				mysql_bind.buffer_length = param.length;
+				mysql_bind.buffer = &param.buffer[0];
+				mysql_bind.buffer_length = param.buffer.size();
 				break;
 			}
 			case MYSQL_TYPE_NULL:
 			{
-				mysql_bind.buffer_type   = param.type;
+				mysql_bind.buffer_type = param.type;
+				mysql_bind.buffer = NULL;
 				mysql_bind.buffer_length = 0;
 				break;
 			}
@@ -201,9 +224,160 @@ void MariaDBStatement::bindParams(std::vector<MariaDBStatement::mysql_bind_param
 			default:
 				throw extDB3Exception("Unknown Field Type: " + std::to_string(param.type));
 		}
-		mysql_bind_params[i] = (std::move(mysql_bind));
 	}
-	mysql_stmt_bind_param(mysql_stmt_ptr, mysql_bind_params);
+	if (mysql_stmt_bind_param(mysql_stmt_ptr, mysql_bind_params.data()) != 0)
+	{
+		throw MariaDBStatementException1(mysql_stmt_ptr);
+	}
+}
+
+
+void MariaDBStatement::executeBulk(std::vector<std::vector<MariaDBStatement::mysql_bind_param>> &rows, std::string &insertID)
+// Executes the statement once for every row of params, statement can't return a result set
+//   MariaDB Connector/C 3.0+ sends all rows in one execute via column-wise array binding, older connectors execute each row
+{
+	if (rows.empty()) return;
+
+	unsigned int params_count = mysql_stmt_param_count(mysql_stmt_ptr);
+	for (auto &row : rows)
+	{
+		if (row.size() != params_count)
+		{
+			throw extDB3Exception("SQL Invalid Number of Inputs Got " + std::to_string(row.size()) + " Expected " + std::to_string(params_count));
+		}
+	}
+	if (mysql_stmt_field_count(mysql_stmt_ptr) > 0)
+	{
+		throw extDB3Exception("Bulk only supports SQL Statements without results");
+	}
+
+	#if defined(MARIADB_PACKAGE_VERSION_ID) && (MARIADB_PACKAGE_VERSION_ID >= 30000)
+		unsigned int array_size = rows.size();
+
+		std::vector<MYSQL_BIND> mysql_binds(params_count);
+		std::vector<std::vector<char*>> column_buffers(params_count);
+		std::vector<std::vector<unsigned long>> column_lengths(params_count);
+		std::vector<std::vector<MYSQL_TIME>> column_times(params_count);
+		std::vector<std::vector<char>> column_numbers(params_count);
+		std::vector<std::vector<char>> column_indicators(params_count);
+
+		for (unsigned int i = 0; i < params_count; ++i)
+		{
+			MYSQL_BIND &mysql_bind = mysql_binds[i];
+			std::memset(&mysql_bind, 0, sizeof(MYSQL_BIND));
+
+			// Column Type from first non NULL row, NULL rows are flagged via indicator
+			enum_field_types type = MYSQL_TYPE_NULL;
+			for (auto &row : rows)
+			{
+				if (row[i].type != MYSQL_TYPE_NULL)
+				{
+					type = row[i].type;
+					break;
+				}
+			}
+
+			column_indicators[i].resize(array_size, STMT_INDICATOR_NONE);
+			switch (type)
+			{
+				case MYSQL_TYPE_DATE:
+				case MYSQL_TYPE_TIME:
+				case MYSQL_TYPE_DATETIME:
+				{
+					column_times[i].resize(array_size);
+					for (unsigned int row_index = 0; row_index < array_size; ++row_index)
+					{
+						MariaDBStatement::mysql_bind_param &param = rows[row_index][i];
+						std::memset(&column_times[i][row_index], 0, sizeof(MYSQL_TIME));
+						if (param.type == MYSQL_TYPE_NULL)
+						{
+							column_indicators[i][row_index] = STMT_INDICATOR_NULL;
+						}	else {
+							std::memset(&param.time_buffer, 0, sizeof(MYSQL_TIME));
+							bindTime(param);
+							column_times[i][row_index] = param.time_buffer;
+						}
+					}
+					mysql_bind.buffer_type = type;
+					mysql_bind.buffer = &column_times[i][0];
+					break;
+				}
+				case MYSQL_TYPE_LONG:
+				case MYSQL_TYPE_LONGLONG:
+				case MYSQL_TYPE_DOUBLE:
+				{
+					std::size_t value_size = (type == MYSQL_TYPE_LONG) ? sizeof(int) : sizeof(long long);
+					column_numbers[i].resize(array_size * value_size, 0);
+					for (unsigned int row_index = 0; row_index < array_size; ++row_index)
+					{
+						MariaDBStatement::mysql_bind_param &param = rows[row_index][i];
+						if (param.type == MYSQL_TYPE_NULL)
+						{
+							column_indicators[i][row_index] = STMT_INDICATOR_NULL;
+						}	else {
+							std::memcpy(&column_numbers[i][row_index * value_size], &param.number_buffer, value_size);
+						}
+					}
+					mysql_bind.buffer_type = type;
+					mysql_bind.buffer = &column_numbers[i][0];
+					break;
+				}
+				case MYSQL_TYPE_LONG_BLOB:
+				{
+					throw extDB3Exception("Field Type not supported: LONGBLOB/LONGTEXT");
+				}
+				default:
+				{
+					column_buffers[i].resize(array_size, nullptr);
+					column_lengths[i].resize(array_size, 0);
+					for (unsigned int row_index = 0; row_index < array_size; ++row_index)
+					{
+						MariaDBStatement::mysql_bind_param &param = rows[row_index][i];
+						if (param.type == MYSQL_TYPE_NULL)
+						{
+							column_indicators[i][row_index] = STMT_INDICATOR_NULL;
+						}	else {
+							column_buffers[i][row_index] = &param.buffer[0];
+							column_lengths[i][row_index] = param.buffer.size();
+						}
+					}
+					mysql_bind.buffer_type = MYSQL_TYPE_STRING;
+					mysql_bind.buffer = &column_buffers[i][0];
+					mysql_bind.length = &column_lengths[i][0];
+				}
+			}
+			mysql_bind.u.indicator = &column_indicators[i][0];
+		}
+
+		mysql_stmt_attr_set(mysql_stmt_ptr, STMT_ATTR_ARRAY_SIZE, &array_size);
+		bool status = ((mysql_stmt_bind_param(mysql_stmt_ptr, mysql_binds.data()) == 0) && (mysql_stmt_execute(mysql_stmt_ptr) == 0));
+		if (status)
+		{
+			insertID = std::to_string(mysql_stmt_insert_id(mysql_stmt_ptr));
+		}
+		array_size = 0;
+		mysql_stmt_attr_set(mysql_stmt_ptr, STMT_ATTR_ARRAY_SIZE, &array_size); // Back to Single Row execute
+		if (!status)
+		{
+			throw MariaDBStatementException1(mysql_stmt_ptr);
+		}
+	#else
+		bool first_row = true;
+		for (auto &row : rows)
+		{
+			bindParams(row);
+			if (mysql_stmt_execute(mysql_stmt_ptr) != 0)
+			{
+				throw MariaDBStatementException1(mysql_stmt_ptr);
+			}
+			if (first_row)
+			{
+				// Match Array Binding, InsertID of the first row
+				insertID = std::to_string(mysql_stmt_insert_id(mysql_stmt_ptr));
+				first_row = false;
+			}
+		}
+	#endif
 }
 
 
@@ -213,18 +387,83 @@ bool MariaDBStatement::errorCheck()
 }
 
 
-void MariaDBStatement::execute(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &results)
+void MariaDBStatement::loadLayout()
+// Result Metadata is only needed for field types / lengths / flags, copied so the MYSQL_RES can be freed straight away
 {
-	mysql_stmt_result_metadata_ptr = mysql_stmt_result_metadata(mysql_stmt_ptr);
-	if (mysql_stmt_result_metadata_ptr)
+	std::shared_ptr<layout_struct> new_layout = std::make_shared<layout_struct>();
+	new_layout->param_count = mysql_stmt_param_count(mysql_stmt_ptr);
+
+	MYSQL_RES *metadata_ptr = mysql_stmt_result_metadata(mysql_stmt_ptr);
+	if (metadata_ptr)
+	{
+		unsigned int metadata_num_fields = mysql_num_fields(metadata_ptr);
+		MYSQL_FIELD *metadata_fields = mysql_fetch_fields(metadata_ptr);
+		new_layout->fields.resize(metadata_num_fields);
+		memset(new_layout->fields.data(), 0, sizeof(MYSQL_FIELD)*metadata_num_fields);
+		for (unsigned int i = 0; i < metadata_num_fields; i++)
+		{
+			new_layout->fields[i].type = metadata_fields[i].type;
+			new_layout->fields[i].length = metadata_fields[i].length;
+			new_layout->fields[i].max_length = metadata_fields[i].max_length;
+			new_layout->fields[i].flags = metadata_fields[i].flags;
+			new_layout->fields[i].decimals = metadata_fields[i].decimals;
+		}
+		mysql_free_result(metadata_ptr);
+	}
+	layout = new_layout;
+}
+
+
+bool MariaDBStatement::layoutMatches(const layout_struct &expected)
+// Compares the current result metadata with expected on everything bindResult uses, field count + type / length / unsigned
+//   A column altered to a different type or length keeps the field count, but needs new result buffers
+{
+	const unsigned int metadata_num_fields = mysql_stmt_field_count(mysql_stmt_ptr);
+	if (metadata_num_fields != expected.fields.size())
+	{
+		return false;
+	}
+	if (metadata_num_fields == 0)
+	{
+		return true;
+	}
+	MYSQL_RES *metadata_ptr = mysql_stmt_result_metadata(mysql_stmt_ptr);
+	if (!metadata_ptr)
+	{
+		return false;
+	}
+	bool matches = true;
+	MYSQL_FIELD *metadata_fields = mysql_fetch_fields(metadata_ptr);
+	for (unsigned int i = 0; i < metadata_num_fields; i++)
 	{
-		num_fields = mysql_num_fields(mysql_stmt_result_metadata_ptr);
-		fields = mysql_fetch_fields(mysql_stmt_result_metadata_ptr);
+		if ((metadata_fields[i].type != expected.fields[i].type) ||
+			(metadata_fields[i].length != expected.fields[i].length) ||
+			((metadata_fields[i].flags & UNSIGNED_FLAG) != (expected.fields[i].flags & UNSIGNED_FLAG)))
+		{
+			matches = false;
+			break;
+		}
+	}
+	mysql_free_result(metadata_ptr);
+	return matches;
+}
+
+
+void MariaDBStatement::bindResult()
+// Result Buffers only change if the statement is re-prepared, so bound once instead of every execute
+{
+	num_fields = 0;
+	fields = NULL;
+	mysql_bind_result.clear();
+	bind_data.clear();
 
-		mysql_bind_result = new MYSQL_BIND[num_fields];
-		memset(mysql_bind_result, 0, sizeof(MYSQL_BIND)*num_fields);
+	if (!layout->fields.empty())
+	{
+		num_fields = static_cast<unsigned int>(layout->fields.size());
+		fields = layout->fields.data();
 
-		bind_data.clear();
+		mysql_bind_result.resize(num_fields);
+		memset(mysql_bind_result.data(), 0, sizeof(MYSQL_BIND)*num_fields);
 		bind_data.resize(num_fields);
 
 		// Setup Buffers
@@ -329,182 +568,296 @@ void MariaDBStatement::execute(std::vector<sql_option> &output_options, std::str
 			mysql_bind_result[i].is_unsigned = (fields[i].flags & UNSIGNED_FLAG) > 0;
 			mysql_bind_result[i].error = &(bind_data[i].error);
 		};
-		if (mysql_stmt_bind_result(mysql_stmt_ptr, mysql_bind_result) != 0)
+		if (mysql_stmt_bind_result(mysql_stmt_ptr, mysql_bind_result.data()) != 0)
 		{
 			throw MariaDBStatementException1(mysql_stmt_ptr);
 		}
-	};
-	
+	}
+}
+
 
+void MariaDBStatement::executeStatement()
+{
 	if (mysql_stmt_execute(mysql_stmt_ptr) != 0)
 	{
 		throw MariaDBStatementException1(mysql_stmt_ptr);
 	}
-	if (mysql_stmt_store_result(mysql_stmt_ptr))
+	if (!layoutMatches(*layout))
+	{
+		// Server re-prepared the statement i.e table altered, result metadata changed
+		loadLayout();
+		bindResult();
+	}
+}
+
+
+void MariaDBStatement::execute(const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, std::string &insertID, MariaDBRowSink &sink, const bool stream_results)
+// stream_results, rows are fetched unbuffered from the server + handed to the sink as they arrive
+{
+	executeStatement();
+	if ((!stream_results) && (mysql_stmt_store_result(mysql_stmt_ptr)))
 	{
 		throw MariaDBStatementException1(mysql_stmt_ptr);
 	}
 
 	insertID = std::to_string(mysql_stmt_insert_id(mysql_stmt_ptr));
 
-	if (mysql_stmt_result_metadata_ptr)
+	if (num_fields > 0)
 	{
-		int error_code = 0;
-		while (true)
+		sink.reserve(fields, num_fields, mysql_stmt_num_rows(mysql_stmt_ptr));
+		try
+		{
+			fetch(output_transforms, strip_chars_mode, sink);
+		}
+		catch (...)
 		{
-			error_code = mysql_stmt_fetch(mysql_stmt_ptr);
-			if ((error_code !=0) && (error_code != MYSQL_NO_DATA))
+			if (stream_results)
 			{
-				throw MariaDBStatementException1(mysql_stmt_ptr);
+				// Unread unbuffered rows would leave the connection out of sync
+				mysql_stmt_free_result(mysql_stmt_ptr);
 			}
-			if (error_code != 0) break;
+			throw;
+		}
+	}
+}
+
 
-			//Process Result
-			std::vector<std::string> result;
-			output_options.resize(num_fields);
-			for (unsigned int i = 0; i < num_fields; i++)
+void MariaDBStatement::execute(const int check_dataType_string, const bool check_dataType_null, std::string &insertID, MariaDBRowSink &sink, const bool stream_results)
+// SQL Protocol BINARY mode, rows are formatted the same as MariaDBQuery::get does for the text protocol
+{
+	executeStatement();
+	if ((!stream_results) && (mysql_stmt_store_result(mysql_stmt_ptr)))
+	{
+		throw MariaDBStatementException1(mysql_stmt_ptr);
+	}
+
+	insertID = std::to_string(mysql_stmt_insert_id(mysql_stmt_ptr));
+
+	if (num_fields > 0)
+	{
+		sink.reserve(fields, num_fields, mysql_stmt_num_rows(mysql_stmt_ptr));
+		const char *null_str = check_dataType_null ? "objNull" : "\"\"";
+		char number_buffer[number_buffer_size];
+		try
+		{
+			while (true)
 			{
-				if (bind_data[i].isNull)
+				int error_code = mysql_stmt_fetch(mysql_stmt_ptr);
+				if ((error_code !=0) && (error_code != MYSQL_NO_DATA))
+				{
+					throw MariaDBStatementException1(mysql_stmt_ptr);
+				}
+				if (error_code != 0) break;
+
+				sink.beginRow();
+				for (unsigned int i = 0; i < num_fields; i++)
 				{
-					if (output_options[i].nullConvert)
+					if (bind_data[i].isNull)
 					{
-						result.emplace_back("objNull");
-					} else {
-						result.emplace_back("\"\"");
+						sink.addField(null_str);
+						continue;
 					}
-				} else {
 					switch (fields[i].type)
 					{
 						case MYSQL_TYPE_DATE:
-						case MYSQL_TYPE_TIME:
-						case MYSQL_TYPE_DATETIME:
+							MariaDBDateTime::append(bind_data[i].buffer_mysql_time, MariaDBDateTime::DATE, sink.beginField());
+							sink.endField();
+							break;
 						case MYSQL_TYPE_TIMESTAMP:
-						{
-							result.emplace_back("[" +
-																		std::to_string(bind_data[i].buffer_mysql_time.year) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.month) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.day) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.hour) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.minute) + "," +
-																		std::to_string(bind_data[i].buffer_mysql_time.second) +
-																	"]");
+						case MYSQL_TYPE_DATETIME:
+							MariaDBDateTime::append(bind_data[i].buffer_mysql_time, MariaDBDateTime::DATETIME, sink.beginField());
+							sink.endField();
+							break;
+						case MYSQL_TYPE_TIME:
+							MariaDBDateTime::append(bind_data[i].buffer_mysql_time, MariaDBDateTime::TIME, sink.beginField());
+							sink.endField();
 							break;
-						}
 						case MYSQL_TYPE_NULL:
+							sink.addField(null_str);
+							break;
+						case MYSQL_TYPE_VAR_STRING:
+						case MYSQL_TYPE_TINY_BLOB:
+						case MYSQL_TYPE_MEDIUM_BLOB:
+						case MYSQL_TYPE_BLOB:
 						{
-							if (output_options[i].nullConvert)
+							if (bind_data[i].length == 0)
+							{
+								sink.addField(null_str);
+							}
+							else if ((fields[i].type == MYSQL_TYPE_VAR_STRING) && (check_dataType_string > 0))
 							{
-								result.emplace_back("objNull");
-							} else {
-								result.emplace_back("\"\"");
+								// TEXT / TEXT2
+								const char quote = (check_dataType_string == 1) ? '"' : '\'';
+								sink.beginField().append(1, quote).append(&bind_data[i].buffer[0], bind_data[i].length).append(1, quote);
+								sink.endField();
+							}	else {
+								sink.addField(&bind_data[i].buffer[0], bind_data[i].length);
 							}
 							break;
 						}
-
-						case MYSQL_TYPE_LONG_BLOB:
+						default:
 						{
-							throw extDB3Exception("MYSQL_TYPE_LONG_BLOB type not supported");
+							std::size_t value_length;
+							const char *value = fieldValue(i, number_buffer, value_length);
+							sink.addField(value, value_length);
 						}
-						default:
-							std::string tmp_str;
+					}
+				}
+				sink.endRow();
+			}
+		}
+		catch (...)
+		{
+			if (stream_results)
+			{
+				// Unread unbuffered rows would leave the connection out of sync
+				mysql_stmt_free_result(mysql_stmt_ptr);
+			}
+			throw;
+		}
+	}
+}
 
-							switch (fields[i].type)
-							{
-								case MYSQL_TYPE_SHORT:
-									tmp_str = std::to_string(bind_data[i].buffer_short);
-									break;
-								case MYSQL_TYPE_DOUBLE:
-									tmp_str = std::to_string(bind_data[i].buffer_double);
-									break;
-								case MYSQL_TYPE_FLOAT:
-									tmp_str = std::to_string(bind_data[i].buffer_float);
-									break;
-								case MYSQL_TYPE_INT24:
-								case MYSQL_TYPE_LONG:
-									tmp_str = std::to_string(bind_data[i].buffer_long);
-									break;
-								case MYSQL_TYPE_LONGLONG:
-									tmp_str = std::to_string(bind_data[i].buffer_longlong);
-									break;
-								default:
-									tmp_str = std::string(&bind_data[i].buffer[0], bind_data[i].length);
-							}
 
-							if (output_options[i].strip)
-							{
-								std::string stripped_str(tmp_str);
-								for (auto &strip_char : strip_chars)
-								{
-									boost::erase_all(stripped_str, std::string(1, strip_char));
-								}
-								if (stripped_str != tmp_str)
-								{
-									switch (strip_chars_mode)
-									{
-									case 2: // Log + Error
-										throw extDB3Exception("Bad Character detected from database query");
-										//case 1: // Log
-										//logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-									}
-									tmp_str = std::move(stripped_str);
-								}
-							}
-							if (output_options[i].beguidConvert)
-							{
-								try
-								{
-									int64_t steamID = std::stoll(tmp_str, nullptr);
-									std::stringstream bestring;
-									int8_t i = 0, parts[8] = { 0 };
-									do parts[i++] = steamID & 0xFF;
-									while (steamID >>= 8);
-									bestring << "BE";
-									for (int i = 0; i < sizeof(parts); i++) {
-										bestring << char(parts[i]);
-									}
-									tmp_str = md5(bestring.str());
-								}
-								catch (std::exception const & e)
-								{
-									tmp_str = "ERROR";
-								}
-							}
-							if (output_options[i].boolConvert)
-							{
-								if (tmp_str == "1")
-								{
-									tmp_str = "true";
-								}
-								else {
-									tmp_str = "false";
-								}
-							}
-							if (output_options[i].string_remove_escape_quotes)
-							{
-								boost::replace_all(tmp_str, "\"\"", "\"");
-							}
-							if (output_options[i].string_add_escape_quotes)
-							{
-								boost::replace_all(tmp_str, "\"", "\"\"");
-							}
-							if (output_options[i].stringify)
-							{
-								tmp_str = "\"" + tmp_str + "\"";
-							}
-							if (output_options[i].stringify2)
+const char *MariaDBStatement::fieldValue(const unsigned int i, char *number_buffer, std::size_t &length)
+// Text of a fetched field, numbers are formatted into number_buffer instead of allocating a string
+{
+	const bool is_unsigned = mysql_bind_result[i].is_unsigned;
+	int number_length = -1;
+	switch (fields[i].type)
+	{
+		case MYSQL_TYPE_SHORT:
+			if (is_unsigned)
+			{
+				number_length = std::snprintf(number_buffer, number_buffer_size, "%u", static_cast<unsigned short>(bind_data[i].buffer_short));
+			}	else {
+				number_length = std::snprintf(number_buffer, number_buffer_size, "%d", bind_data[i].buffer_short);
+			}
+			break;
+		case MYSQL_TYPE_DOUBLE:
+			number_length = std::snprintf(number_buffer, number_buffer_size, "%f", bind_data[i].buffer_double);
+			break;
+		case MYSQL_TYPE_FLOAT:
+			number_length = std::snprintf(number_buffer, number_buffer_size, "%f", bind_data[i].buffer_float);
+			break;
+		case MYSQL_TYPE_INT24:
+		case MYSQL_TYPE_LONG:
+			if (is_unsigned)
+			{
+				number_length = std::snprintf(number_buffer, number_buffer_size, "%u", static_cast<unsigned int>(bind_data[i].buffer_long));
+			}	else {
+				number_length = std::snprintf(number_buffer, number_buffer_size, "%d", bind_data[i].buffer_long);
+			}
+			break;
+		case MYSQL_TYPE_LONGLONG:
+			if (is_unsigned)
+			{
+				number_length = std::snprintf(number_buffer, number_buffer_size, "%llu", static_cast<unsigned long long>(bind_data[i].buffer_longlong));
+			}	else {
+				number_length = std::snprintf(number_buffer, number_buffer_size, "%lld", bind_data[i].buffer_longlong);
+			}
+			break;
+		default:
+			break;
+	}
+	if (number_length < 0)
+	{
+		// Not a number i.e DECIMAL / STRING, already formatted as text by the server
+		length = bind_data[i].length;
+		return &bind_data[i].buffer[0];
+	}
+	length = number_length;
+	return number_buffer;
+}
+
+
+void MariaDBStatement::executeCursor(const unsigned long prefetch_rows)
+// Opens a read only server side cursor, rows are then read via fetch prefetch_rows at a time from the server
+//   Cursor stays open until the statement is closed or executed again
+{
+	unsigned long cursor_type = CURSOR_TYPE_READ_ONLY;
+	unsigned long prefetch = (prefetch_rows > 0) ? prefetch_rows : 1;
+	if ((mysql_stmt_attr_set(mysql_stmt_ptr, STMT_ATTR_CURSOR_TYPE, &cursor_type) != 0) || (mysql_stmt_attr_set(mysql_stmt_ptr, STMT_ATTR_PREFETCH_ROWS, &prefetch) != 0))
+	{
+		throw MariaDBStatementException1(mysql_stmt_ptr);
+	}
+	executeStatement();
+}
+
+
+bool MariaDBStatement::fetch(const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, MariaDBRowSink &sink, const std::size_t max_rows)
+// Hands rows from the current result to the sink, max_rows == 0 reads the whole result
+//   Returns true if it stopped at max_rows, false once the result is finished
+{
+	if (num_fields == 0)
+	{
+		return false;
+	}
+	std::size_t num_rows = 0;
+	int error_code = 0;
+	while ((max_rows == 0) || (num_rows < max_rows))
+	{
+		error_code = mysql_stmt_fetch(mysql_stmt_ptr);
+		if ((error_code !=0) && (error_code != MYSQL_NO_DATA))
+		{
+			throw MariaDBStatementException1(mysql_stmt_ptr);
+		}
+		if (error_code != 0) return false;
+
+		//Process Result
+		sink.beginRow();
+		for (unsigned int i = 0; i < num_fields; i++)
+		{
+			const MariaDBTransform &transform = (i < output_transforms.size()) ? output_transforms[i] : MariaDBTransform::none;
+			if (bind_data[i].isNull)
+			{
+				transform.applyNull(sink.beginField());
+				sink.endField();
+			} else {
+				switch (fields[i].type)
+				{
+					case MYSQL_TYPE_DATE:
+					case MYSQL_TYPE_TIME:
+					case MYSQL_TYPE_DATETIME:
+					case MYSQL_TYPE_TIMESTAMP:
+					{
+						MariaDBDateTime::append(bind_data[i].buffer_mysql_time, MariaDBDateTime::DATETIME, sink.beginField());
+						sink.endField();
+						break;
+					}
+					case MYSQL_TYPE_NULL:
+					{
+						transform.applyNull(sink.beginField());
+						sink.endField();
+						break;
+					}
+
+					case MYSQL_TYPE_LONG_BLOB:
+					{
+						throw extDB3Exception("MYSQL_TYPE_LONG_BLOB type not supported");
+					}
+					default:
+					{
+						char number_buffer[number_buffer_size];
+						std::size_t value_length;
+						const char *value = fieldValue(i, number_buffer, value_length);
+						if (transform.empty())
+						{
+							sink.addField(value, value_length);
+						}	else {
+							bool clean = transform.apply(value, value_length, sink.beginField());
+							sink.endField();
+							if ((!clean) && (strip_chars_mode == 2)) // Log + Error
 							{
-								tmp_str = "'" + tmp_str + "'";
+								throw extDB3Exception("Bad Character detected from database query");
 							}
-							result.push_back(std::move(tmp_str));
+						}
 					}
 				}
 			}
-			results.push_back(std::move(result));
 		}
+		sink.endRow();
+		++num_rows;
 	}
-
-	mysql_free_result(mysql_stmt_result_metadata_ptr);
-	mysql_stmt_result_metadata_ptr = NULL;
-	delete[] mysql_bind_result;
-	bind_data.clear();
+	return true;
 }
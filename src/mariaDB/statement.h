@@ -13,6 +13,8 @@
 #include "abstract.h"
 #include "binder.h"
 #include "connector.h"
+#include "row_sink.h"
+#include "transform.h"
 
 
 class MariaDBStatement
@@ -25,32 +27,63 @@ public:
 	{
 		enum_field_types type = MYSQL_TYPE_NULL;
 		std::string buffer;
-		std::unique_ptr<char[]> buffer_c;
 		std::size_t length = 0;
 		bool is_unsigned = false;
 		MYSQL_TIME time_buffer;
+		union
+		{
+			int int_value;           // MYSQL_TYPE_LONG
+			long long bigint_value;  // MYSQL_TYPE_LONGLONG
+			double double_value;     // MYSQL_TYPE_DOUBLE
+		} number_buffer;
+	};
+
+	struct layout_struct
+	// Param Count + Result Field Layout of a prepared SQL Query, identical on every connection
+	//   Shared between sessions preparing the same SQL, so each statement only keeps its handle + bind buffers
+	{
+		unsigned long param_count = 0;
+		std::vector<MYSQL_FIELD> fields; // Copied from result metadata, name / table / db strings not kept
 	};
 
 	void init(MariaDBConnector &connector);
 	void create();
-	void prepare(std::string & sql_query);
+	void prepare(std::string & sql_query, std::shared_ptr<const layout_struct> shared_layout=nullptr);
+	std::shared_ptr<const layout_struct> getLayout() const;
 	unsigned long getParamsCount();
 	void bindParams(std::vector<mysql_bind_param> &params);
-	void execute(std::vector<sql_option> &output_options, std::string &strip_chars, int &strip_chars_mode, std::string &insertID, std::vector<std::vector<std::string>> &result_vec);
+	void execute(const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, std::string &insertID, MariaDBRowSink &sink, const bool stream_results=false);
+	void execute(const int check_dataType_string, const bool check_dataType_null, std::string &insertID, MariaDBRowSink &sink, const bool stream_results=false);
+	void executeCursor(const unsigned long prefetch_rows);
+	bool fetch(const std::vector<MariaDBTransform> &output_transforms, const int strip_chars_mode, MariaDBRowSink &sink, const std::size_t max_rows=0);
+	void executeBulk(std::vector<std::vector<mysql_bind_param>> &rows, std::string &insertID);
 	bool errorCheck();
 
 private:
+	void executeStatement();
+	const char *fieldValue(const unsigned int i, char *number_buffer, std::size_t &length);
+	void bindTime(mysql_bind_param &param);
+	void loadLayout();
+	bool layoutMatches(const layout_struct &expected);
+	void bindResult();
+
 	bool prepared = false;
 	MariaDBConnector *connector_ptr;
 
-	MYSQL_RES *mysql_stmt_result_metadata_ptr = NULL;
 	MYSQL_STMT *mysql_stmt_ptr = NULL;
 
-	MYSQL_BIND *mysql_bind_params = NULL;
-	MYSQL_BIND *mysql_bind_result = NULL;
-	MYSQL_FIELD *fields = NULL;
+	std::shared_ptr<const layout_struct> layout;
+	const MYSQL_FIELD *fields = NULL; // layout->fields
+
+	// Param Binding, points at the mysql_bind_param buffers passed to bindParams
+	std::vector<MYSQL_BIND> mysql_bind_params;
+
+	// Fits any DOUBLE formatted with %f (DBL_MAX is 309 digits)
+	static const int number_buffer_size = 320;
 
-	unsigned int num_fields;
+	// Result Binding, setup once at prepare + reused every execute
+	std::vector<MYSQL_BIND> mysql_bind_result;
+	unsigned int num_fields = 0;
 
 	struct mysql_bind_field
 	{
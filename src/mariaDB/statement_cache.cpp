@@ -0,0 +1,69 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "statement_cache.h"
+
+
+void MariaDBStatementCache::setMaxSize(const std::size_t max_size)
+{
+	this->max_size = max_size;
+	while ((max_size > 0) && (statements.size() > max_size))
+	{
+		statements_index.erase(statements.back().first);
+		statements.pop_back();
+	}
+}
+
+
+std::vector<MariaDBStatement> *MariaDBStatementCache::find(const std::string &key)
+{
+	auto index_itr = statements_index.find(key);
+	if (index_itr == statements_index.end())
+	{
+		return nullptr;
+	}
+	statements.splice(statements.begin(), statements, index_itr->second);
+	return &(index_itr->second->second);
+}
+
+
+std::vector<MariaDBStatement> &MariaDBStatementCache::insert(const std::string &key, const std::size_t num_of_statements)
+// Replaces any existing entry, statements are default constructed + still need init / create / prepare
+{
+	erase(key);
+	if ((max_size > 0) && (statements.size() >= max_size))
+	{
+		statements_index.erase(statements.back().first);
+		statements.pop_back(); // Closes the evicted statements
+	}
+	statements.push_front(std::make_pair(key, std::vector<MariaDBStatement>()));
+	statements.front().second.resize(num_of_statements);
+	statements_index[key] = statements.begin();
+	return statements.front().second;
+}
+
+
+void MariaDBStatementCache::erase(const std::string &key)
+{
+	auto index_itr = statements_index.find(key);
+	if (index_itr != statements_index.end())
+	{
+		statements.erase(index_itr->second);
+		statements_index.erase(index_itr);
+	}
+}
+
+
+void MariaDBStatementCache::clear()
+{
+	statements_index.clear();
+	statements.clear();
+}
+
+
+std::size_t MariaDBStatementCache::size() const
+{
+	return statements.size();
+}
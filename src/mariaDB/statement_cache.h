@@ -0,0 +1,36 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "statement.h"
+
+
+class MariaDBStatementCache
+// Prepared Statements of a single session by key, least recently used entry is closed once max_size is reached
+//   Entries are list nodes, pointers returned by find / insert stay valid until the entry is erased
+{
+public:
+	void setMaxSize(const std::size_t max_size);
+
+	std::vector<MariaDBStatement> *find(const std::string &key);
+	std::vector<MariaDBStatement> &insert(const std::string &key, const std::size_t num_of_statements);
+	void erase(const std::string &key);
+	void clear();
+	std::size_t size() const;
+
+private:
+	typedef std::list<std::pair<std::string, std::vector<MariaDBStatement>>> statements_list;
+
+	statements_list statements; // Front == most recently used
+	std::unordered_map<std::string, statements_list::iterator> statements_index;
+	std::size_t max_size = 0; // 0 == unbounded
+};
@@ -0,0 +1,61 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "transaction.h"
+
+#include <cstring>
+#include <string>
+
+#include "exceptions.h"
+
+
+MariaDBTransaction::MariaDBTransaction(MariaDBConnector &connector, const bool send_begin)
+// send_begin == false, START TRANSACTION is sent as part of a multi statement query
+{
+	connector_ptr = &connector;
+	open = true;
+	if (send_begin)
+	{
+		const char *sql_query = "START TRANSACTION";
+		if (mysql_real_query(connector_ptr->mysql_ptr, sql_query, std::strlen(sql_query)) != 0)
+		{
+			open = false;
+			throw MariaDBQueryException(connector_ptr->mysql_ptr);
+		}
+	}
+}
+
+
+MariaDBTransaction::~MariaDBTransaction(void)
+{
+	rollback();
+}
+
+
+void MariaDBTransaction::commit(const bool send_commit)
+// send_commit == false, COMMIT was already sent as part of a multi statement query
+{
+	if (open)
+	{
+		open = false;
+		if ((send_commit) && (mysql_commit(connector_ptr->mysql_ptr) != 0))
+		{
+			std::string error_msg(mysql_error(connector_ptr->mysql_ptr));
+			mysql_rollback(connector_ptr->mysql_ptr);
+			throw extDB3Exception("Transaction Commit Failed: " + error_msg);
+		}
+	}
+}
+
+
+void MariaDBTransaction::rollback()
+{
+	if (open)
+	{
+		open = false;
+		connector_ptr->discardResults();
+		mysql_rollback(connector_ptr->mysql_ptr);
+	}
+}
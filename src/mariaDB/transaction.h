@@ -0,0 +1,24 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include "connector.h"
+
+
+class MariaDBTransaction
+// Rolls back on destruction, unless commit was called
+{
+public:
+	MariaDBTransaction(MariaDBConnector &connector, const bool send_begin=true);
+	~MariaDBTransaction();
+
+	void commit(const bool send_commit=true);
+	void rollback();
+
+private:
+	MariaDBConnector *connector_ptr;
+	bool open;
+};
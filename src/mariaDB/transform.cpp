@@ -0,0 +1,212 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "transform.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "../md5/md5.h"
+
+
+const MariaDBTransform MariaDBTransform::none;
+
+
+void MariaDBTransform::compile(const sql_option &option, const std::string &strip_chars, const directions direction)
+{
+	this->direction = direction;
+
+	strip = option.strip && !strip_chars.empty();
+	std::memset(strip_table, 0, sizeof(strip_table));
+	if (strip)
+	{
+		for (auto &strip_char : strip_chars)
+		{
+			strip_table[static_cast<unsigned char>(strip_char)] = true;
+		}
+	}
+
+	beguid_convert = option.beguidConvert;
+	bool_convert = option.boolConvert;
+	null_convert = option.nullConvert;
+
+	remove_escape_quotes = option.string_remove_escape_quotes;
+	add_escape_quotes = option.string_add_escape_quotes;
+	remove_quotes = option.string_remove_quotes;
+
+	// string2 wraps the result of string
+	prefix.clear();
+	suffix.clear();
+	if (option.stringify2)
+	{
+		prefix += '\'';
+	}
+	if (option.stringify)
+	{
+		prefix += '"';
+		suffix += '"';
+	}
+	if (option.stringify2)
+	{
+		suffix += '\'';
+	}
+}
+
+
+bool MariaDBTransform::apply(const char *value, std::size_t length, std::string &output) const
+// Order matches the original option chain: strip, beguid, bool, escape quotes, remove quotes, string, string2
+//   Returns false if Strip Chars were found, output still gets the stripped value
+{
+	bool clean = true;
+	bool filter = strip;
+	const char *pos = value;
+	const char *end = value + length;
+
+	char value_buffer[40];
+	if (beguid_convert || bool_convert)
+	{
+		// Whole Value Replacement, computed from the stripped value
+		std::size_t value_length = 0;
+		bool overflow = false;
+		for (; pos < end; ++pos)
+		{
+			if (filter && strip_table[static_cast<unsigned char>(*pos)])
+			{
+				clean = false;
+				continue;
+			}
+			if (value_length < (sizeof(value_buffer) - 1))
+			{
+				value_buffer[value_length++] = *pos;
+			}	else {
+				overflow = true;
+			}
+		}
+		value_buffer[value_length] = '\0';
+
+		if (beguid_convert)
+		{
+			char *number_end = nullptr;
+			errno = 0;
+			int64_t steamID = std::strtoll(value_buffer, &number_end, 10);
+			if (overflow || (number_end == value_buffer) || (errno == ERANGE))
+			{
+				std::memcpy(value_buffer, "ERROR", 6);
+				value_length = 5;
+			}	else {
+				char bestring[10] = { 'B', 'E' };
+				for (int i = 0; i < 8; ++i)
+				{
+					bestring[i + 2] = static_cast<char>(steamID & 0xFF);
+					steamID >>= 8;
+				}
+				std::string beguid_str = md5(std::string(bestring, sizeof(bestring)));
+				value_length = beguid_str.copy(value_buffer, sizeof(value_buffer) - 1);
+				value_buffer[value_length] = '\0';
+			}
+			overflow = false;
+		}
+		if (bool_convert)
+		{
+			const char *bool_str;
+			if (direction == OUTPUT)
+			{
+				// Database -> SQF
+				bool_str = ((!overflow) && (value_length == 1) && (value_buffer[0] == '1')) ? "true" : "false";
+			}	else {
+				// SQF -> Database
+				bool is_true = (!overflow) && (value_length == 4);
+				for (std::size_t i = 0; is_true && (i < 4); ++i)
+				{
+					is_true = ((value_buffer[i] | 0x20) == "true"[i]);
+				}
+				bool_str = is_true ? "1" : "0";
+			}
+			value_length = std::strlen(bool_str);
+			std::memcpy(value_buffer, bool_str, value_length + 1);
+		}
+		pos = value_buffer;
+		end = value_buffer + value_length;
+		filter = false;
+	}
+
+	output += prefix;
+	if (!(filter || remove_escape_quotes || add_escape_quotes || remove_quotes))
+	{
+		output.append(pos, end - pos);
+	}	else {
+		output.reserve(output.size() + (end - pos) + suffix.size());
+		while (pos < end)
+		{
+			char c = *pos++;
+			if (filter && strip_table[static_cast<unsigned char>(c)])
+			{
+				clean = false;
+				continue;
+			}
+			if (remove_quotes && ((c == '"') || (c == '\'')))
+			{
+				continue;
+			}
+			if ((c == '"') && (remove_escape_quotes || add_escape_quotes))
+			{
+				// Run of Quotes, remove_escape_quotes halves it ("" -> ") then add_escape_quotes doubles it
+				std::size_t run = 1;
+				while (pos < end)
+				{
+					if (filter && strip_table[static_cast<unsigned char>(*pos)])
+					{
+						clean = false;
+						++pos;
+						continue;
+					}
+					if (*pos != '"') break;
+					++run;
+					++pos;
+				}
+				if (remove_escape_quotes)
+				{
+					run = (run + 1) / 2;
+				}
+				if (add_escape_quotes)
+				{
+					run *= 2;
+				}
+				output.append(run, '"');
+				continue;
+			}
+			output += c;
+		}
+	}
+	output += suffix;
+	return clean;
+}
+
+
+void MariaDBTransform::applyNull(std::string &output) const
+// Database NULL -> SQF
+{
+	if (null_convert)
+	{
+		output += "objNull";
+	}	else {
+		output += "\"\"";
+	}
+}
+
+
+bool MariaDBTransform::isNull(std::size_t length) const
+// Empty Input Value with nullConvert, beguid + bool always produce a value
+{
+	return null_convert && (length == 0) && !(beguid_convert || bool_convert);
+}
+
+
+bool MariaDBTransform::empty() const
+{
+	return !(strip || beguid_convert || bool_convert || remove_escape_quotes || add_escape_quotes || remove_quotes || !prefix.empty());
+}
@@ -0,0 +1,44 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <string>
+
+#include "abstract.h"
+
+
+class MariaDBTransform
+// SQL_CUSTOM INPUT/OUTPUT Options for a single column, compiled once at loadConfig
+//   apply appends the transformed value straight into the output buffer in one pass
+{
+public:
+	enum directions { INPUT, OUTPUT };
+
+	void compile(const sql_option &option, const std::string &strip_chars, const directions direction);
+
+	bool apply(const char *value, std::size_t length, std::string &output) const;
+	void applyNull(std::string &output) const;
+	bool isNull(std::size_t length) const;
+	bool empty() const;
+
+	static const MariaDBTransform none;
+
+private:
+	bool strip = false;
+	bool strip_table[256] = {};
+
+	bool beguid_convert = false;
+	bool bool_convert = false;
+	bool null_convert = false;
+	directions direction = OUTPUT;
+
+	bool remove_escape_quotes = false;
+	bool add_escape_quotes = false;
+	bool remove_quotes = false;
+
+	std::string prefix;
+	std::string suffix;
+};
@@ -12,9 +12,19 @@
 
 // Code is from Intel threading building blocks
 
+#ifdef TEST_APP
+	#include <atomic>
+	// Test Application only, counts allocations for benchmarks
+	std::atomic<unsigned long long> test_app_allocations(0);
+	#define COUNT_ALLOCATION ++test_app_allocations
+#else
+	#define COUNT_ALLOCATION
+#endif
+
 
 void* operator new (size_t size)
 {
+	COUNT_ALLOCATION;
 	if (size == 0) size = 1;
 	void* ptr = scalable_malloc(size);
 	if (ptr == NULL) {
@@ -25,6 +35,7 @@ void* operator new (size_t size)
 
 void* operator new[] (size_t size)
 {
+	COUNT_ALLOCATION;
 	void* ptr = scalable_malloc(size);
 	if (ptr == NULL) {
 		throw std::bad_alloc();
@@ -34,6 +45,7 @@ void* operator new[] (size_t size)
 
 void* operator new (size_t size, const std::nothrow_t&)
 {
+	COUNT_ALLOCATION;
 	if (size == 0) size = 1;
 	if (void* ptr = scalable_malloc(size))
 		return ptr;
@@ -8,6 +8,8 @@
 #include "../mariaDB/exceptions.h"
 #include "../mariaDB/session.h"
 
+#include <functional>
+
 #include <boost/algorithm/string.hpp>
 
 
@@ -41,6 +43,14 @@ bool SQL::init(AbstractExt *extension, const std::string &database_id, const std
 		{
 			check_dataType_null = true;
 		}
+		else if (boost::algorithm::iequals(token, std::string("STREAM")))
+		{
+			stream_results = true;
+		}
+		else if (boost::algorithm::iequals(token, std::string("BINARY")))
+		{
+			binary_protocol = true;
+		}
 	}
 
 	#ifdef DEBUG_TESTING
@@ -48,6 +58,14 @@ bool SQL::init(AbstractExt *extension, const std::string &database_id, const std
 		{
 			extension_ptr->console->info("extDB3: SQL: Initialized: Add Quotes around TEXT Datatypes mode: {0}", check_dataType_string);
 		}
+		if (stream_results)
+		{
+			extension_ptr->console->info("extDB3: SQL: Initialized: Stream Results");
+		}
+		if (binary_protocol)
+		{
+			extension_ptr->console->info("extDB3: SQL: Initialized: Binary Protocol");
+		}
 		if (check_dataType_null)
 		{
 			extension_ptr->console->info("extDB3: SQL: Initialized: NULL = objNull");
@@ -62,6 +80,14 @@ bool SQL::init(AbstractExt *extension, const std::string &database_id, const std
 	{
 		extension_ptr->logger->info("extDB3: SQL: Initialized: Add Quotes around TEXT Datatypes mode: {0}", check_dataType_string);
 	}
+	if (stream_results)
+	{
+		extension_ptr->logger->info("extDB3: SQL: Initialized: Stream Results");
+	}
+	if (binary_protocol)
+	{
+		extension_ptr->logger->info("extDB3: SQL: Initialized: Binary Protocol");
+	}
 	if (check_dataType_null)
 	{
 		extension_ptr->logger->info("extDB3: SQL: Initialized: NULL = objNull");
@@ -75,6 +101,51 @@ bool SQL::init(AbstractExt *extension, const std::string &database_id, const std
 }
 
 
+MariaDBStatement *SQL::binaryStatement(MariaDBSession &session, std::string &input_str)
+// BINARY mode, each distinct SQL Query is prepared once per session + kept in its LRU cache
+//   Returns nullptr if the query can't run as a Prepared Statement, cached so it goes straight to the text protocol next time
+{
+	std::vector<MariaDBStatement> *statements = session.data->sql_statements.find(input_str);
+	if (statements == nullptr)
+	{
+		statements = &session.data->sql_statements.insert(input_str, 1);
+		if (boost::algorithm::istarts_with(boost::algorithm::trim_left_copy(input_str), "CALL"))
+		{
+			// Stored Procedures return an extra result set, left to the text protocol
+			statements->clear();
+			return nullptr;
+		}
+		try
+		{
+			MariaDBStatement &statement = statements->front();
+			statement.init(session.data->connector);
+			statement.create();
+			statement.prepare(input_str);
+			if (statement.getParamsCount() > 0)
+			{
+				statements->clear(); // ? Markers, nothing to bind them to
+			}
+		}
+		catch (MariaDBStatementException0 &e)
+		{
+			// i.e Multi Statements or Syntax Error, text protocol reports the error
+			statements->clear();
+		}
+		catch (MariaDBStatementException1 &e)
+		{
+			session.data->sql_statements.erase(input_str);
+			throw;
+		}
+		catch (extDB3Exception &e)
+		{
+			// Unsupported Result Type i.e LONG BLOB
+			statements->clear();
+		}
+	}
+	return statements->empty() ? nullptr : &statements->front();
+}
+
+
 bool SQL::callProtocol(std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id)
 {
 	#ifdef DEBUG_TESTING
@@ -83,40 +154,45 @@ bool SQL::callProtocol(std::string input_str, std::string &result, const bool as
 	#ifdef DEBUG_LOGGING
 		extension_ptr->logger->info("extDB3: SQL: Trace: Input: {0}", input_str);
 	#endif
+	result = "[1,[";
+	MariaDBSQFRowSink sink(result);
+	bool success = false;
 	try
 	{
 		std::string insertID = "0";
 		MariaDBSession session(database_pool);
-		session.data->query.send(input_str);
-
-		std::vector<std::vector<std::string>> result_vec;
-		session.data->query.get(check_dataType_string, check_dataType_null, insertID, result_vec);
+		MariaDBStatement *statement = nullptr;
+		if (binary_protocol)
+		{
+			statement = binaryStatement(session, input_str);
+		}
 
-		result = "[1,[";
-		if (result_vec.size() > 0)
+		if (stream_results)
 		{
-			for(auto &row: result_vec)
+			// Only ASYNC + SAVE Calls can be streamed, otherwise rows are fetched unbuffered but returned in one go
+			const int stream_size = extension_ptr->stored_results_ptr->streamSize(unique_id);
+			if (stream_size > 0)
 			{
-				result += "[";
-				if (row.size() > 0)
-				{
-					for(auto &field: row)
-					{
-						if (field.empty())
-						{
-							result += "\"\"";
-						} else {
-							result += field;
-						}
-						result += ",";
-					}
-					result.pop_back();
-				}
-				result += "],";
+				sink.stream(std::bind(&ResultStore::stream, extension_ptr->stored_results_ptr, static_cast<unsigned long>(unique_id), std::placeholders::_1), stream_size);
 			}
-			result.pop_back();
+		}
+		if (statement)
+		{
+			try
+			{
+				statement->execute(check_dataType_string, check_dataType_null, insertID, sink, stream_results);
+			}
+			catch (...)
+			{
+				session.data->sql_statements.erase(input_str); // Prepared again next call, i.e after a reconnect
+				throw;
+			}
+		}	else {
+			session.data->query.send(input_str);
+			session.data->query.get(check_dataType_string, check_dataType_null, insertID, sink, stream_results);
 		}
 		result += "]]";
+		success = true;
 
 		#ifdef DEBUG_TESTING
 			extension_ptr->console->info("extDB3: SQL: Trace: Result: {0}", result);
@@ -135,6 +211,26 @@ bool SQL::callProtocol(std::string input_str, std::string &result, const bool as
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
 		result = "[0,\"Error MariaDBQueryException Exception\"]";
 	}
+	catch (MariaDBStatementException1 &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+		result = "[0,\"Error MariaDBStatementException1 Exception\"]";
+	}
+	catch (extDB3Exception &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+		result = "[0,\"Error extDB3Exception Exception\"]";
+	}
 	catch (MariaDBConnectorException &e)
 	{
 		#ifdef DEBUG_TESTING
@@ -145,5 +241,11 @@ bool SQL::callProtocol(std::string input_str, std::string &result, const bool as
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBConnectorException: Input: {0}", input_str);
 		result = "[0,\"Error MariaDBConnectorException Exception\"]";
 	}
+	if (sink.streamed() && !success)
+	{
+		// Rows already sent to SQF, error is added as 3rd element i.e [1,[...],[0,"Error ..."]]
+		result.insert(0, "],");
+		result += "]";
+	}
 	return true;
 }
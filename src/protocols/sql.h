@@ -6,6 +6,7 @@
 #pragma once
 
 #include "abstract_protocol.h"
+#include "../mariaDB/session.h"
 
 
 class SQL: public AbstractProtocol
@@ -17,6 +18,10 @@ public:
 private:
 	MariaDBPool *database_pool;
 
+	MariaDBStatement *binaryStatement(MariaDBSession &session, std::string &input_str);
+
 	int check_dataType_string = 0;
 	bool check_dataType_null = false;
+	bool stream_results = false;
+	bool binary_protocol = false;
 };
@@ -6,6 +6,13 @@
 #include "sql_custom.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
@@ -217,6 +224,18 @@ bool SQL_CUSTOM::loadConfig(boost::filesystem::path &config_path)
 							{
 								option.mysql_escape = true;
 							}
+							else if	(boost::algorithm::iequals(sub_token, std::string("int")) == 1)
+							{
+								option.value_type = sql_option::VALUE_INT;
+							}
+							else if	(boost::algorithm::iequals(sub_token, std::string("bigint")) == 1)
+							{
+								option.value_type = sql_option::VALUE_BIGINT;
+							}
+							else if	((boost::algorithm::iequals(sub_token, std::string("double")) == 1) || (boost::algorithm::iequals(sub_token, std::string("float")) == 1))
+							{
+								option.value_type = sql_option::VALUE_DOUBLE;
+							}
 							else
 							{
 								try
@@ -360,6 +379,114 @@ bool SQL_CUSTOM::loadConfig(boost::filesystem::path &config_path)
 			}
 			ptree.get_child(section.first).erase("Number of Retrys");
 
+			path = section.first + ".Transaction";
+			calls[section.first].transaction = ptree.get(path, false);
+			ptree.get_child(section.first).erase("Transaction");
+
+			path = section.first + ".Pipeline";
+			calls[section.first].pipeline = ptree.get(path, false);
+			ptree.get_child(section.first).erase("Pipeline");
+
+			path = section.first + ".Bulk";
+			calls[section.first].bulk = ptree.get(path, false);
+			ptree.get_child(section.first).erase("Bulk");
+
+			path = section.first + ".Stream Results";
+			calls[section.first].stream_results = ptree.get(path, false);
+			ptree.get_child(section.first).erase("Stream Results");
+			if ((calls[section.first].stream_results) && ((calls[section.first].bulk) || (calls[section.first].returnInsertID) || (calls[section.first].returnInsertIDString)))
+			{
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Stream Results can't be used with Bulk or Return InsertID", section.first);
+				#endif
+				extension_ptr->logger->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Stream Results can't be used with Bulk or Return InsertID", section.first);
+				status = false;
+			}
+
+			path = section.first + ".Cursor";
+			calls[section.first].cursor = ptree.get(path, false);
+			ptree.get_child(section.first).erase("Cursor");
+			path = section.first + ".Cursor Prefetch Rows";
+			calls[section.first].cursor_prefetch_rows = ptree.get(path, 100);
+			ptree.get_child(section.first).erase("Cursor Prefetch Rows");
+			if (calls[section.first].cursor)
+			{
+				// Cursor returns a Cursor ID instead of rows, rows are read via 9:FETCH
+				if ((!calls[section.first].preparedStatement) || (calls[section.first].sql.size() != 1))
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Cursor requires Prepared Statement = true + a single SQL Statement", section.first);
+					#endif
+					extension_ptr->logger->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Cursor requires Prepared Statement = true + a single SQL Statement", section.first);
+					status = false;
+				}
+				if ((calls[section.first].bulk) || (calls[section.first].stream_results) || (calls[section.first].transaction) || (calls[section.first].returnInsertID) || (calls[section.first].returnInsertIDString))
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Cursor can't be used with Bulk, Stream Results, Transaction or Return InsertID", section.first);
+					#endif
+					extension_ptr->logger->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Cursor can't be used with Bulk, Stream Results, Transaction or Return InsertID", section.first);
+					status = false;
+				}
+			}
+
+			path = section.first + ".Read Only";
+			calls[section.first].read_only = ptree.get(path, false);
+			ptree.get_child(section.first).erase("Read Only");
+			if ((calls[section.first].read_only) && ((calls[section.first].bulk) || (calls[section.first].transaction) || (calls[section.first].pipeline) || (calls[section.first].returnInsertID) || (calls[section.first].returnInsertIDString)))
+			{
+				// Read Only Calls go to a Read Replica if the Database has any
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Read Only can't be used with Bulk, Transaction, Pipeline or Return InsertID", section.first);
+				#endif
+				extension_ptr->logger->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Read Only can't be used with Bulk, Transaction, Pipeline or Return InsertID", section.first);
+				status = false;
+			}
+
+			if ((calls[section.first].bulk) && (!calls[section.first].preparedStatement))
+			{
+				#ifdef DEBUG_TESTING
+					extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Bulk requires Prepared Statement = true", section.first);
+				#endif
+				extension_ptr->logger->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Bulk requires Prepared Statement = true", section.first);
+				status = false;
+			}
+			if (calls[section.first].pipeline)
+			{
+				// Pipeline sends all SQL Statements as one multi statement query, only works without Prepared Statements
+				if (calls[section.first].preparedStatement)
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Pipeline requires Prepared Statement = false", section.first);
+					#endif
+					extension_ptr->logger->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Pipeline requires Prepared Statement = false", section.first);
+					status = false;
+				}
+				if (!database_pool->multiStatements())
+				{
+					#ifdef DEBUG_TESTING
+						extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Pipeline requires Multi Statements = true in Database Config", section.first);
+					#endif
+					extension_ptr->logger->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Pipeline requires Multi Statements = true in Database Config", section.first);
+					status = false;
+				}
+			}
+
+			// Compile SQLx_INPUTS + OUTPUT Options, needs Strip Chars
+			for (auto &sql_entry : calls[section.first].sql)
+			{
+				sql_entry.input_transforms.resize(sql_entry.input_options.size());
+				for (std::size_t i = 0; i < sql_entry.input_options.size(); ++i)
+				{
+					sql_entry.input_transforms[i].compile(sql_entry.input_options[i], calls[section.first].strip_chars, MariaDBTransform::INPUT);
+				}
+				sql_entry.output_transforms.resize(sql_entry.output_options.size());
+				for (std::size_t i = 0; i < sql_entry.output_options.size(); ++i)
+				{
+					sql_entry.output_transforms[i].compile(sql_entry.output_options[i], calls[section.first].strip_chars, MariaDBTransform::OUTPUT);
+				}
+			}
+
 			for (auto& value : section.second) {
 				#ifdef DEBUG_TESTING
 					extension_ptr->console->info("extDB3: SQL_CUSTOM Config Error: Section: {0} Unknown Setting: {1}", section.first, value.first);
@@ -388,100 +515,60 @@ bool SQL_CUSTOM::loadConfig(boost::filesystem::path &config_path)
 	}
 }
 
-bool SQL_CUSTOM::query(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
+bool SQL_CUSTOM::query(std::string &input_str, std::string &result, MariaDBRowSink &sink, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
 {
 	// -------------------
 	// Raw SQL
 	// -------------------
+	std::string pipeline_str;
+	if ((calls_itr->second.pipeline) && (calls_itr->second.transaction))
+	{
+		pipeline_str = "START TRANSACTION;";
+	}
 	for (auto &sql : calls_itr->second.sql)
 	{
 		std::string sql_str = sql.sql;
 		std::string tmp_str;
 		for (int i = 0; i < sql.input_options.size(); ++i)
 		{
-			int value_number = sql.input_options[i].value_number;
-			tmp_str = tokens[value_number];
-			if (sql.input_options[i].strip)
-			{
-				std::string stripped_str = tmp_str;
-				for (auto &strip_char : calls_itr->second.strip_chars)
-				{
-					boost::erase_all(stripped_str, std::string(1, strip_char));
-				}
-				if (stripped_str != tmp_str)
-				{
-					switch (calls_itr->second.strip_chars_mode)
-					{
-						case 2: // Log + Error
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, tmp_str);
-							result = "[0,\"Error Strip Char Found\"]";
-							return false;
-						case 1: // Log
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, tmp_str);
-					}
-					tmp_str = std::move(stripped_str);
-				}
-			}
-			if (sql.input_options[i].beguidConvert)
-			{
-				std::string beguid_str;
-				try
-				{
-					int64_t steamID = std::stoll(tmp_str, nullptr);
-					std::stringstream bestring;
-					int8_t i = 0, parts[8] = { 0 };
-					do parts[i++] = steamID & 0xFF;
-					while (steamID >>= 8);
-					bestring << "BE";
-					for (int i = 0; i < sizeof(parts); i++) {
-						bestring << char(parts[i]);
-					}
-					beguid_str = md5(bestring.str());
-				}
-				catch(std::exception const &e)
-				{
-					beguid_str = e.what();
-				}
-				tmp_str = beguid_str;
-			}
-			if (sql.input_options[i].boolConvert)
+			sql_option &option = sql.input_options[i];
+			MariaDBTransform &transform = sql.input_transforms[i];
+			std::string &token = tokens[option.value_number];
+			bool is_null = transform.isNull(token.size());
+			tmp_str.clear();
+			if (!transform.apply((is_null ? "objNull" : token.data()), (is_null ? 7 : token.size()), tmp_str))
 			{
-				if (boost::algorithm::iequals(tmp_str, std::string("1")) == 1)
+				switch (calls_itr->second.strip_chars_mode)
 				{
-					tmp_str = "true";
-				} else {
-					tmp_str = "false";
+					case 2: // Log + Error
+						extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, token);
+						result = "[0,\"Error Strip Char Found\"]";
+						return false;
+					case 1: // Log
+						extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, token);
 				}
 			}
-			if (sql.input_options[i].nullConvert)
+			if ((option.value_type != sql_option::VALUE_STRING) && !is_null)
 			{
-				if (tmp_str.empty())
+				// Typed Input, only the parsed number is inserted into the query, never the token itself
+				MariaDBStatement::mysql_bind_param number_param;
+				number_param.buffer = tmp_str;
+				parseNumberInput(option, number_param);
+				char number_buffer[32];
+				switch (option.value_type)
 				{
-					tmp_str = "objNull";
+					case sql_option::VALUE_INT:
+						std::snprintf(number_buffer, sizeof(number_buffer), "%d", number_param.number_buffer.int_value);
+						break;
+					case sql_option::VALUE_BIGINT:
+						std::snprintf(number_buffer, sizeof(number_buffer), "%lld", number_param.number_buffer.bigint_value);
+						break;
+					default:
+						std::snprintf(number_buffer, sizeof(number_buffer), "%.17g", number_param.number_buffer.double_value);
 				}
+				tmp_str = number_buffer;
 			}
-			if (sql.input_options[i].string_remove_escape_quotes)
-			{
-				boost::replace_all(tmp_str, "\"\"", "\"");
-			}
-			if (sql.input_options[i].string_add_escape_quotes)
-			{
-				boost::replace_all(tmp_str, "\"", "\"\"");
-			}
-			if (sql.input_options[i].string_remove_quotes)
-			{
-				boost::replace_all(tmp_str, "\"", "");
-				boost::replace_all(tmp_str, "\'", "");
-			}
-			if (sql.input_options[i].stringify)
-			{
-				tmp_str = "\"" + tmp_str + "\"";
-			}
-			if (sql.input_options[i].stringify2)
-			{
-				tmp_str = "'" + tmp_str + "'";
-			}
-			if (sql.input_options[i].mysql_escape)
+			if (option.mysql_escape)
 			{
 				std::string tmp_escaped_str(" ", (tmp_str.length() * 2) + 1);
 				mysql_real_escape_string(session.data->connector.mysql_ptr, &tmp_escaped_str[0], tmp_str.c_str(), tmp_str.length());
@@ -489,12 +576,45 @@ bool SQL_CUSTOM::query(std::string &input_str, std::string &result, std::vector<
 			}
 			boost::replace_all(sql_str, ("$CUSTOM_" + std::to_string(i + 1) + "$"), tmp_str.c_str());  //TODO Improve this
 		}
+		if (calls_itr->second.pipeline)
+		{
+			boost::trim_right_if(sql_str, boost::is_any_of("; "));
+			pipeline_str += sql_str;
+			pipeline_str += ';';
+			continue;
+		}
 		try
 		{
 			auto &session_query_itr = session.data->query;
 			session.data->query.send(sql_str);
 			//session.data->query.get(insertID, result_vec); // TODO: OUTPUT OPTIONS SUPPORT
-			session.data->query.get(sql.output_options, calls_itr->second.strip_chars, calls_itr->second.strip_chars_mode, insertID, result_vec);
+			session.data->query.get(sql.output_transforms, calls_itr->second.strip_chars_mode, insertID, sink, calls_itr->second.stream_results);
+		}
+		catch (MariaDBQueryException &e)
+		{
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+			#endif
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+			result = "[0,\"Error MariaDBQueryException Exception\"]";
+			return false;
+		}
+	}
+	if (calls_itr->second.pipeline)
+	{
+		// One Round Trip, OUTPUT Options are the same for every SQL Statement in a Call
+		if (calls_itr->second.transaction)
+		{
+			pipeline_str += "COMMIT";
+		}	else {
+			pipeline_str.pop_back();
+		}
+		try
+		{
+			session.data->query.send(pipeline_str);
+			session.data->query.get(calls_itr->second.sql.back().output_transforms, calls_itr->second.strip_chars_mode, insertID, sink, calls_itr->second.stream_results);
 		}
 		catch (MariaDBQueryException &e)
 		{
@@ -507,24 +627,35 @@ bool SQL_CUSTOM::query(std::string &input_str, std::string &result, std::vector<
 			result = "[0,\"Error MariaDBQueryException Exception\"]";
 			return false;
 		}
+		catch (extDB3Exception &e)
+		{
+			session.data->connector.discardResults();
+			throw;
+		}
 	}
 	return true;
 }
 
-bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
+bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &result, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
 {
 	try
 	{
-		if (session.data->statements.count(callname) == 0)
+		if (session.data->statements.find(callname) == nullptr)
 		{
-			session.data->statements[callname].resize(calls_itr->second.sql.size());
+			std::vector<MariaDBStatement> &session_statements = session.data->statements.insert(callname, calls_itr->second.sql.size());
 
 			for (int sql_index = 0; sql_index < calls_itr->second.sql.size(); ++sql_index)
 			{
-				session_statement_itr = &session.data->statements[callname][sql_index];
+				sql_struct &sql = calls_itr->second.sql[sql_index];
+				std::shared_ptr<const MariaDBStatement::layout_struct> layout = std::atomic_load(&sql.layout);
+				session_statement_itr = &session_statements[sql_index];
 				session_statement_itr->init(session.data->connector);
 				session_statement_itr->create();
-				session_statement_itr->prepare(calls_itr->second.sql[sql_index].sql);
+				session_statement_itr->prepare(sql.sql, layout);
+				if (session_statement_itr->getLayout() != layout)
+				{
+					std::atomic_store(&sql.layout, session_statement_itr->getLayout());
+				}
 			}
 		}
 	}
@@ -537,7 +668,7 @@ bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &r
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
 		result = "[0,\"Error MariaDBStatementException0 Exception\"]";
-		session.resetSession();
+		session.resetStatements(callname);
 		return false;
 	}
 	catch (MariaDBStatementException1 &e)
@@ -549,7 +680,7 @@ bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &r
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
 		result = "[0,\"Error MariaDBStatementException1 Exception\"]";
-		session.resetSession();
+		session.resetStatements(callname);
 		return false;
 	}
 	catch (extDB3Exception &e)
@@ -561,121 +692,193 @@ bool SQL_CUSTOM::preparedStatementPrepare(std::string &input_str, std::string &r
 		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
 		extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
 		result = "[0,\"Error extDB3Exception Exception\"]";
-		session.resetSession();
+		session.resetStatements(callname);
 		return false;
 	}
 	return true;
 }
 
-bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID)
+bool SQL_CUSTOM::processInputs(std::string &input_str, std::string &result, sql_struct &sql, call_struct &call, std::vector<std::string> &tokens, std::vector<MariaDBStatement::mysql_bind_param> &processed_inputs)
+// Applies SQLx_INPUTS Options to tokens, returns false + sets result if a Strip Char Error
 {
-	for (int sql_index = 0; sql_index < calls_itr->second.sql.size(); ++sql_index)
+	processed_inputs.resize(sql.input_options.size());
+	for (int i = 0; i < processed_inputs.size(); ++i)
 	{
-		std::vector<MariaDBStatement::mysql_bind_param> processed_inputs;
-		processed_inputs.resize(calls_itr->second.sql[sql_index].input_options.size());
-		for (int i = 0; i < processed_inputs.size(); ++i)
+		MariaDBTransform &transform = sql.input_transforms[i];
+		std::string &token = tokens[sql.input_options[i].value_number];
+		processed_inputs[i].type = MYSQL_TYPE_VARCHAR;
+		processed_inputs[i].buffer.clear();
+		if (!transform.apply(token.data(), token.size(), processed_inputs[i].buffer))
 		{
-			processed_inputs[i].type = MYSQL_TYPE_VARCHAR;
-			processed_inputs[i].buffer = tokens[calls_itr->second.sql[sql_index].input_options[i].value_number];
-			processed_inputs[i].length = processed_inputs[i].buffer.size();
-			if (calls_itr->second.sql[sql_index].input_options[i].strip)
-			{
-				std::string stripped_str = processed_inputs[i].buffer;
-				for (auto &strip_char : calls_itr->second.strip_chars)
-				{
-					boost::erase_all(stripped_str, std::string(1, strip_char));
-				}
-				if (stripped_str != processed_inputs[i].buffer)
-				{
-					switch (calls_itr->second.strip_chars_mode)
-					{
-						case 2: // Log + Error
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-							result = "[0,\"Error Strip Char Found\"]";
-							return true;
-						case 1: // Log
-							extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, processed_inputs[i].buffer);
-					}
-					processed_inputs[i].buffer = std::move(stripped_str);
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
-				}
-			}
-			if (calls_itr->second.sql[sql_index].input_options[i].beguidConvert)
+			switch (call.strip_chars_mode)
 			{
-				std::string beguid_str;
-				try
-				{
-					int64_t steamID = std::stoll(processed_inputs[i].buffer, nullptr);
-					std::stringstream bestring;
-					int8_t i = 0, parts[8] = { 0 };
-					do parts[i++] = steamID & 0xFF;
-					while (steamID >>= 8);
-					bestring << "BE";
-					for (int i = 0; i < sizeof(parts); i++) {
-						bestring << char(parts[i]);
-					}
-					beguid_str = std::move(md5(bestring.str()));
-				}
-				catch(std::exception const &e)
-				{
-					beguid_str = "ERROR";
-				}
-				processed_inputs[i].buffer = beguid_str;
-				processed_inputs[i].length = beguid_str.size();
-			}
-			if (calls_itr->second.sql[sql_index].input_options[i].boolConvert)
-			{
-				if (boost::algorithm::iequals(processed_inputs[i].buffer, std::string("true")) == 1)
-				{
-					processed_inputs[i].buffer = "1";
-				} else {
-					processed_inputs[i].buffer = "0";
-				}
-				processed_inputs[i].length = processed_inputs[i].buffer.size();
+				case 2: // Log + Error
+					extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, token);
+					result = "[0,\"Error Strip Char Found\"]";
+					return false;
+				case 1: // Log
+					extension_ptr->logger->warn("extDB3: SQL_CUSTOM: Error Bad Char Detected: Input: {0} Token: {1}", input_str, token);
 			}
-			if (calls_itr->second.sql[sql_index].input_options[i].nullConvert)
-			{
-				if (processed_inputs[i].buffer.empty())
-				{
-					processed_inputs[i].type = MYSQL_TYPE_NULL;
-				}
-			}
-			if (calls_itr->second.sql[sql_index].input_options[i].string_remove_escape_quotes)
-			{
-					boost::replace_all(processed_inputs[i].buffer, "\"\"", "\"");
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
-			}
-			if (calls_itr->second.sql[sql_index].input_options[i].string_add_escape_quotes)
-			{
-					boost::replace_all(processed_inputs[i].buffer, "\"", "\"\"");
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
-			}
-			if (calls_itr->second.sql[sql_index].input_options[i].string_remove_quotes)
-			{
-					boost::replace_all(processed_inputs[i].buffer, "\"", "");
-					boost::replace_all(processed_inputs[i].buffer, "\'", "");
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
-			}
-			if (calls_itr->second.sql[sql_index].input_options[i].stringify)
+		}
+		processed_inputs[i].length = processed_inputs[i].buffer.size();
+		if (transform.isNull(token.size()))
+		{
+			processed_inputs[i].type = MYSQL_TYPE_NULL;
+		}
+		if (sql.input_options[i].timeConvert)
+		{
+			processed_inputs[i].type = MYSQL_TYPE_DATETIME;
+		}
+		if ((sql.input_options[i].value_type != sql_option::VALUE_STRING) && (processed_inputs[i].type != MYSQL_TYPE_NULL))
+		{
+			parseNumberInput(sql.input_options[i], processed_inputs[i]);
+		}
+	}
+	return true;
+}
+
+bool SQL_CUSTOM::beginTransaction(std::string &input_str, std::string &result, MariaDBSession &session, std::unique_ptr<MariaDBTransaction> &transaction, const bool send_begin)
+// START TRANSACTION failing is handled like a failed query, so the call is retried / moved off a lost Read Replica
+{
+	try
+	{
+		transaction.reset(new MariaDBTransaction(session.data->connector, send_begin));
+	}
+	catch (MariaDBQueryException &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+		result = "[0,\"Error MariaDBQueryException Exception\"]";
+		return false;
+	}
+	return true;
+}
+
+void SQL_CUSTOM::parseNumberInput(sql_option &option, MariaDBStatement::mysql_bind_param &param)
+// Converts param.buffer for Typed SQLx_INPUTS (int / bigint / double), throws extDB3Exception if it isn't a valid number
+//   Only plain decimal, strto* would also accept leading whitespace, hex, nan + inf
+{
+	const char *start = param.buffer.c_str();
+	const char *digits = ((*start == '+') || (*start == '-')) ? (start + 1) : start;
+	if (!(std::isdigit(static_cast<unsigned char>(*digits)) || (*digits == '.')) || ((digits[0] == '0') && ((digits[1] == 'x') || (digits[1] == 'X'))))
+	{
+		throw extDB3Exception("Invalid Number Input: " + param.buffer);
+	}
+	char *end = nullptr;
+	errno = 0;
+	switch (option.value_type)
+	{
+		case sql_option::VALUE_INT:
+		{
+			long long value = std::strtoll(start, &end, 10);
+			if ((value < INT_MIN) || (value > INT_MAX))
 			{
-					processed_inputs[i].buffer = "\"" + processed_inputs[i].buffer + "\"";
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+				errno = ERANGE;
 			}
-			if (calls_itr->second.sql[sql_index].input_options[i].stringify2)
+			param.number_buffer.int_value = static_cast<int>(value);
+			param.type = MYSQL_TYPE_LONG;
+			break;
+		}
+		case sql_option::VALUE_BIGINT:
+		{
+			param.number_buffer.bigint_value = std::strtoll(start, &end, 10);
+			param.type = MYSQL_TYPE_LONGLONG;
+			break;
+		}
+		case sql_option::VALUE_DOUBLE:
+		{
+			param.number_buffer.double_value = std::strtod(start, &end);
+			if (!std::isfinite(param.number_buffer.double_value))
 			{
-					processed_inputs[i].buffer = "'" + processed_inputs[i].buffer + "'";
-					processed_inputs[i].length = processed_inputs[i].buffer.size();
+				errno = ERANGE;
 			}
-			if (calls_itr->second.sql[sql_index].input_options[i].timeConvert)
+			param.type = MYSQL_TYPE_DOUBLE;
+			break;
+		}
+		default:
+			return;
+	}
+	if ((end == start) || (*end != '\0') || (errno == ERANGE))
+	{
+		throw extDB3Exception("Invalid Number Input: " + param.buffer);
+	}
+}
+
+bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &result, MariaDBRowSink &sink, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID)
+{
+	for (int sql_index = 0; sql_index < calls_itr->second.sql.size(); ++sql_index)
+	{
+		std::vector<MariaDBStatement::mysql_bind_param> processed_inputs;
+		if (!processInputs(input_str, result, calls_itr->second.sql[sql_index], calls_itr->second, tokens, processed_inputs))
+		{
+			return false;
+		}
+		try
+		{
+			session_statement_itr = &(*session.data->statements.find(callname))[sql_index];
+			session_statement_itr->bindParams(processed_inputs);
+			session_statement_itr->execute(calls_itr->second.sql[sql_index].output_transforms, calls_itr->second.strip_chars_mode, insertID, sink, calls_itr->second.stream_results);
+		}
+		catch (MariaDBStatementException0 &e)
+		{
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+			#endif
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+			result = "[0,\"Error MariaDBStatementException0 Exception\"]";
+			session.resetStatements(callname);
+			return false;
+		}
+		catch (MariaDBStatementException1 &e)
+		{
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
+				extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+			#endif
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
+			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+			result = "[0,\"Error MariaDBStatementException1 Exception\"]";
+			session.resetStatements(callname);
+			return false;
+		}
+		catch (extDB3Exception &e)
+		{
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
+				extension_ptr->console->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+			#endif
+			extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
+			extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
+			result = "[0,\"Error extDB3Exception Exception\"]";
+			session.resetStatements(callname);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool SQL_CUSTOM::preparedStatementExecuteBulk(std::string &input_str, std::string &result, MariaDBSession &session, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::vector<std::string>> &bulk_tokens, std::string &insertID)
+// Bulk = true, every SQL Statement runs once per input row via array binding
+{
+	for (int sql_index = 0; sql_index < calls_itr->second.sql.size(); ++sql_index)
+	{
+		std::vector<std::vector<MariaDBStatement::mysql_bind_param>> processed_rows(bulk_tokens.size());
+		for (std::size_t row_index = 0; row_index < bulk_tokens.size(); ++row_index)
+		{
+			if (!processInputs(input_str, result, calls_itr->second.sql[sql_index], calls_itr->second, bulk_tokens[row_index], processed_rows[row_index]))
 			{
-				processed_inputs[i].type = MYSQL_TYPE_DATETIME;
+				return false;
 			}
 		}
 		try
 		{
-			session_statement_itr = &session.data->statements[callname][sql_index];
-			session_statement_itr->bindParams(processed_inputs);
-			session_statement_itr->execute(calls_itr->second.sql[sql_index].output_options, calls_itr->second.strip_chars, calls_itr->second.strip_chars_mode, insertID, result_vec);
+			(*session.data->statements.find(callname))[sql_index].executeBulk(processed_rows, insertID);
 		}
 		catch (MariaDBStatementException0 &e)
 		{
@@ -686,7 +889,7 @@ bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &r
 			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
 			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
 			result = "[0,\"Error MariaDBStatementException0 Exception\"]";
-			session.resetSession();
+			session.resetStatements(callname);
 			return false;
 		}
 		catch (MariaDBStatementException1 &e)
@@ -698,7 +901,7 @@ bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &r
 			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
 			extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
 			result = "[0,\"Error MariaDBStatementException1 Exception\"]";
-			session.resetSession();
+			session.resetStatements(callname);
 			return false;
 		}
 		catch (extDB3Exception &e)
@@ -710,13 +913,52 @@ bool SQL_CUSTOM::preparedStatementExecute(std::string &input_str, std::string &r
 			extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: {0}", e.what());
 			extension_ptr->logger->error("extDB3: SQL: Error extDB3Exception: Input: {0}", input_str);
 			result = "[0,\"Error extDB3Exception Exception\"]";
-			session.resetSession();
+			session.resetStatements(callname);
 			return false;
 		}
 	}
 	return true;
 }
 
+bool SQL_CUSTOM::openCursor(std::string &input_str, std::string &result, std::vector<std::string> &tokens, std::unordered_map<std::string, call_struct>::iterator &calls_itr)
+// Cursor = true, result is [1,"<Cursor ID>"] for 9:FETCH:<Cursor ID>:<Rows> + 9:CLOSE:<Cursor ID>
+{
+	sql_struct &sql = calls_itr->second.sql.front();
+	std::vector<MariaDBStatement::mysql_bind_param> processed_inputs;
+	if (!processInputs(input_str, result, sql, calls_itr->second, tokens, processed_inputs))
+	{
+		return true;
+	}
+	try
+	{
+		std::unique_ptr<MariaDBCursor> cursor(new MariaDBCursor(database_pool, sql.output_transforms, calls_itr->second.strip_chars_mode, calls_itr->second.read_only));
+		cursor->open(sql.sql, processed_inputs, calls_itr->second.cursor_prefetch_rows);
+		const unsigned long cursor_id = extension_ptr->cursors_ptr->add(std::move(cursor));
+		result = "[1,\"" + std::to_string(cursor_id) + "\"]";
+	}
+	catch (MariaDBStatementException0 &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException0: Input: {0}", input_str);
+		result = "[0,\"Error MariaDBStatementException0 Exception\"]";
+	}
+	catch (MariaDBStatementException1 &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBStatementException1: Input: {0}", input_str);
+		result = "[0,\"Error MariaDBStatementException1 Exception\"]";
+	}
+	return true;
+}
+
 bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const bool async_method, const unsigned int unique_id)
 {
 	#ifdef DEBUG_TESTING
@@ -751,13 +993,43 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 		return true;
 	}
 
-	std::vector<std::vector<std::string>> result_vec;
+	// Rows are written straight into result by the sink, reset before every attempt as errors replace result
+	result = "[1,[";
+	MariaDBSQFRowSink sink(result);
+	bool success = false;
 	try
 	{
-		MariaDBSession session(database_pool);
-
 		std::vector<std::string> tokens;
-		if (calls_itr->second.input_sqf_parser)
+		std::vector<std::vector<std::string>> bulk_tokens;
+		if (calls_itr->second.bulk)
+		{
+			// Bulk Input CallName:[[Row 1 Inputs],[Row 2 Inputs],...]
+			std::vector<std::string> rows;
+			if (found != std::string::npos)
+			{
+				std::string rows_str = input_str.substr(found+1);
+				sqf::parser(rows_str, rows, true);
+			}
+			if (rows.empty())
+			{
+				throw extDB3Exception("Bulk Invalid Format, Expected Array of Input Arrays");
+			}
+			bulk_tokens.resize(rows.size());
+			for (std::size_t i = 0; i < rows.size(); ++i)
+			{
+				bulk_tokens[i].push_back(callname);
+				if ((rows[i].empty()) || (rows[i].front() != '[') || (!sqf::parser(rows[i], bulk_tokens[i])))
+				{
+					throw extDB3Exception("Bulk Invalid Format, Row " + std::to_string(i + 1) + " is not an Array");
+				}
+				if ((bulk_tokens[i].size()-1) != calls_itr->second.highest_input_value)
+				{
+					throw extDB3Exception("Config Invalid Number Number of Inputs Got " + std::to_string(bulk_tokens[i].size()-1) + " Expected " + std::to_string(calls_itr->second.highest_input_value) + " Row " + std::to_string(i + 1));
+				}
+			}
+			tokens.push_back(callname);
+		}
+		else if (calls_itr->second.input_sqf_parser)
 		{
 			if (found != std::string::npos)
 			{
@@ -769,23 +1041,64 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 			boost::split(tokens, input_str, boost::is_any_of(":"));
 		}
 
-		if ((tokens.size()-1) != calls_itr->second.highest_input_value)
+		if ((!calls_itr->second.bulk) && ((tokens.size()-1) != calls_itr->second.highest_input_value))
 		{
 			throw extDB3Exception("Config Invalid Number Number of Inputs Got " + std::to_string(tokens.size()-1) + " Expected " + std::to_string(calls_itr->second.highest_input_value));
 		}
 
-		bool success = false;
+		if (calls_itr->second.cursor)
+		{
+			// Cursor keeps its own session pinned until closed
+			return openCursor(input_str, result, tokens, calls_itr);
+		}
+
+		MariaDBSession session(database_pool, calls_itr->second.read_only);
+
+		if (calls_itr->second.stream_results)
+		{
+			// Only ASYNC + SAVE Calls can be streamed, otherwise rows are fetched unbuffered but returned in one go
+			const int stream_size = extension_ptr->stored_results_ptr->streamSize(unique_id);
+			if (stream_size > 0)
+			{
+				sink.stream(std::bind(&ResultStore::stream, extension_ptr->stored_results_ptr, static_cast<unsigned long>(unique_id), std::placeholders::_1), stream_size);
+			}
+		}
+
 		if (!calls_itr->second.preparedStatement)
 		{
 			for (int i = 0; i <= calls_itr->second.num_of_retrys; ++i)
 			{
-				if (!query(input_str, result, result_vec, tokens, session, insertID, calls_itr))
+				if (sink.streamed())
+				{
+					break; // Rows already sent to SQF, can't retry
+				}
+				result = "[1,[";
+				sink.clear();
+				// Transaction is rolled back when it goes out of scope uncommitted
+				//   Pipeline sends START TRANSACTION + COMMIT as part of its multi statement query
+				std::unique_ptr<MariaDBTransaction> transaction;
+				if ((calls_itr->second.transaction) && (!beginTransaction(input_str, result, session, transaction, !calls_itr->second.pipeline)))
+				{
+					// DO NOTHING
+				}
+				else if (!query(input_str, result, sink, tokens, session, insertID, calls_itr))
 				{
 					// DO NOTHING
 				} else {
+					if (transaction)
+					{
+						transaction->commit(!calls_itr->second.pipeline);
+					}
 					success = true;
 					break;
 				}
+				if ((!sink.streamed()) && (session.replicaLost()))
+				{
+					// Read Replica went away, redo the call on the primary without using up a retry
+					transaction.reset();
+					session.fallbackToPrimary();
+					--i;
+				}
 			}
 
 		} else {
@@ -794,19 +1107,47 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 			// -------------------
 			for (int i = 0; i <= calls_itr->second.num_of_retrys; ++i)
 			{
+				if (sink.streamed())
+				{
+					break; // Rows already sent to SQF, can't retry
+				}
+				result = "[1,[";
+				sink.clear();
 				MariaDBStatement *session_statement_itr = nullptr;
-				if (!preparedStatementPrepare(input_str, result, result_vec, session, session_statement_itr, callname, calls_itr))
+				if (!preparedStatementPrepare(input_str, result, session, session_statement_itr, callname, calls_itr))
 				{
 					// DO NOTHING
 				} else {
-					if (!preparedStatementExecute(input_str, result, result_vec, session, session_statement_itr, callname, calls_itr, tokens, insertID))
+					std::unique_ptr<MariaDBTransaction> transaction;
+					bool executed;
+					if ((calls_itr->second.transaction) && (!beginTransaction(input_str, result, session, transaction, true)))
+					{
+						executed = false;
+					}
+					else if (calls_itr->second.bulk)
+					{
+						executed = preparedStatementExecuteBulk(input_str, result, session, callname, calls_itr, bulk_tokens, insertID);
+					}	else {
+						executed = preparedStatementExecute(input_str, result, sink, session, session_statement_itr, callname, calls_itr, tokens, insertID);
+					}
+					if (!executed)
 					{
 						// DO NOTHING
 					} else {
+						if (transaction)
+						{
+							transaction->commit();
+						}
 						success = true;
 						break;
 					}
 				}
+				if ((!sink.streamed()) && (session.replicaLost()))
+				{
+					// Read Replica went away, redo the call on the primary without using up a retry
+					session.fallbackToPrimary();
+					--i;
+				}
 			}
 		}
 		if (!success)
@@ -817,50 +1158,26 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 			#endif
 			extension_ptr->logger->error("extDB3: SQL: Error Max Retrys Reached");
 			extension_ptr->logger->error("extDB3: SQL: Error Max Retrys Reached");
-			return true;
-		}
-		result = "[1,[";
-		if (calls_itr->second.returnInsertID)
-		{
-			result += std::move(insertID) + ",[";
-		} else if (calls_itr->second.returnInsertIDString)
-		{
-			result += "\"" + std::move(insertID) + "\",[";
-		}
-		if (result_vec.size() > 0)
-		{
-			for(auto &row: result_vec)
+		}	else {
+			if (calls_itr->second.returnInsertID)
 			{
-				result += "[";
-				if (row.size() > 0)
-				{
-					for(auto &field: row)
-					{
-						if (field.empty())
-						{
-							result += "\"\"";
-						} else {
-							result += field;
-						}
-						result += ",";
-					}
-					result.pop_back();
-				}
-				result += "],";
+				result.insert(4, insertID + ",[");
+			} else if (calls_itr->second.returnInsertIDString)
+			{
+				result.insert(4, "\"" + insertID + "\",[");
 			}
-			result.pop_back();
-		}
-		result += "]]";
-		if ((calls_itr->second.returnInsertID) || (calls_itr->second.returnInsertIDString))
-		{
-			result += "]";
+			result += "]]";
+			if ((calls_itr->second.returnInsertID) || (calls_itr->second.returnInsertIDString))
+			{
+				result += "]";
+			}
+			#ifdef DEBUG_TESTING
+				extension_ptr->console->info("extDB3: SQL_CUSTOM: Trace: Result: {0}", result);
+			#endif
+			#ifdef DEBUG_LOGGING
+				extension_ptr->logger->info("extDB3: SQL_CUSTOM: Trace: Result: {0}", result);
+			#endif
 		}
-		#ifdef DEBUG_TESTING
-			extension_ptr->console->info("extDB3: SQL_CUSTOM: Trace: Result: {0}", result);
-		#endif
-		#ifdef DEBUG_LOGGING
-			extension_ptr->logger->info("extDB3: SQL_CUSTOM: Trace: Result: {0}", result);
-		#endif
 	}
 	catch (extDB3Exception &e) // Make new exception & renamed it
 	{
@@ -882,5 +1199,21 @@ bool SQL_CUSTOM::callProtocol (std::string input_str, std::string &result, const
 		extension_ptr->logger->error("extDB3: SQL: Error MariaDBConnectorException: Input: {0}", input_str);
 		result = "[0,\"Error MariaDBConnectorException Exception\"]";
 	}
+	catch (MariaDBQueryException &e)
+	{
+		#ifdef DEBUG_TESTING
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
+			extension_ptr->console->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+		#endif
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: {0}", e.what());
+		extension_ptr->logger->error("extDB3: SQL: Error MariaDBQueryException: Input: {0}", input_str);
+		result = "[0,\"Error MariaDBQueryException Exception\"]";
+	}
+	if (sink.streamed() && !success)
+	{
+		// Rows already sent to SQF, error is added as 3rd element i.e [1,[...],[0,"Error ..."]]
+		result.insert(0, "],");
+		result += "]";
+	}
 	return true;
 }
@@ -7,13 +7,17 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/ini_parser.hpp>
+#include <memory>
 #include <thread>
 #include <unordered_map>
 
 
 #include "abstract_protocol.h"
 #include "../mariaDB/abstract.h"
+#include "../mariaDB/cursor.h"
 #include "../mariaDB/session.h"
+#include "../mariaDB/transaction.h"
+#include "../mariaDB/transform.h"
 
 #define EXTDB_SQL_CUSTOM_REQUIRED_VERSION 1
 #define EXTDB_SQL_CUSTOM_LATEST_VERSION 1
@@ -27,11 +31,23 @@ class SQL_CUSTOM: public AbstractProtocol
 			std::string sql;
 			std::vector<sql_option> input_options;
 			std::vector<sql_option> output_options;
+			std::vector<MariaDBTransform> input_transforms;
+			std::vector<MariaDBTransform> output_transforms;
+
+			// Layout from the first connection to prepare sql, reused by the others (std::atomic_load / atomic_store)
+			std::shared_ptr<const MariaDBStatement::layout_struct> layout;
 		};
 
 		struct call_struct
 		{
 			bool preparedStatement = false;
+			bool transaction = false;
+			bool pipeline = false;
+			bool bulk = false;
+			bool stream_results = false;
+			bool cursor = false;
+			unsigned long cursor_prefetch_rows = 100;
+			bool read_only = false;
 			bool returnInsertID = false;
 			bool returnInsertIDString = false;
 
@@ -53,8 +69,13 @@ class SQL_CUSTOM: public AbstractProtocol
 
 		std::unordered_map<std::string, call_struct> calls;
 
-		bool query(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
-		bool preparedStatementPrepare(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
-		bool preparedStatementExecute(std::string &input_str, std::string &result, std::vector<std::vector<std::string>> &result_vec, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID);
+		bool query(std::string &input_str, std::string &result, MariaDBRowSink &sink, std::vector<std::string> &tokens, MariaDBSession &session, std::string &insertID, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
+		bool preparedStatementPrepare(std::string &input_str, std::string &result, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
+		bool preparedStatementExecute(std::string &input_str, std::string &result, MariaDBRowSink &sink, MariaDBSession &session, MariaDBStatement *session_statement_itr, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::string> &tokens, std::string &insertID);
+		bool preparedStatementExecuteBulk(std::string &input_str, std::string &result, MariaDBSession &session, std::string callname, std::unordered_map<std::string, call_struct>::iterator &calls_itr, std::vector<std::vector<std::string>> &bulk_tokens, std::string &insertID);
+		bool beginTransaction(std::string &input_str, std::string &result, MariaDBSession &session, std::unique_ptr<MariaDBTransaction> &transaction, const bool send_begin);
+		void parseNumberInput(sql_option &option, MariaDBStatement::mysql_bind_param &param);
+		bool processInputs(std::string &input_str, std::string &result, sql_struct &sql, call_struct &call, std::vector<std::string> &tokens, std::vector<MariaDBStatement::mysql_bind_param> &processed_inputs);
+		bool openCursor(std::string &input_str, std::string &result, std::vector<std::string> &tokens, std::unordered_map<std::string, call_struct>::iterator &calls_itr);
 		bool loadConfig(boost::filesystem::path &config_path);
 };
@@ -0,0 +1,247 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "result_store.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+ResultStore::ResultStore(std::size_t num_of_shards, BufferPool *buffer_pool) : num_of_shards(num_of_shards), unique_id_counter(100), buffer_pool_ptr(buffer_pool) // Can't be value 1
+{
+	if (this->num_of_shards == 0)
+	{
+		this->num_of_shards = 1;
+	}
+	shards.reset(new shard_struct[this->num_of_shards]);
+}
+
+
+ResultStore::~ResultStore(void)
+{
+}
+
+
+ResultStore::shard_struct& ResultStore::getShard(const unsigned long &unique_id)
+{
+	return shards[unique_id % num_of_shards];
+}
+
+
+void ResultStore::recycle(std::string &buffer)
+// Called after shard lock is released
+{
+	if (buffer_pool_ptr)
+	{
+		buffer_pool_ptr->release(buffer);
+	}
+}
+
+
+unsigned long ResultStore::reserve(const int stream_size)
+// Reserves Unique ID for ASYNC + SAVE Calls, result is marked as wait until worker saves it
+//   stream_size > 0, worker may stream the result in parts of stream_size before saving it
+{
+	const unsigned long unique_id = unique_id_counter++;
+	shard_struct &shard = getShard(unique_id);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	resultData &result_data = shard.results[unique_id];
+	result_data.wait = true;
+	result_data.stream_size = stream_size;
+	return unique_id;
+}
+
+
+void ResultStore::split(resultData &result_data, const int &output_size)
+// Called on Worker Thread before taking shard lock, records part size + number of parts for Multi-Part Message
+{
+	result_data.read_pos = 0;
+	if ((output_size > 0) && (result_data.message.length() > static_cast<std::string::size_type>(output_size)))
+	{
+		result_data.chunk_size = output_size;
+		result_data.num_of_chunks = static_cast<unsigned long>((result_data.message.length() + output_size - 1) / output_size);
+	} else {
+		result_data.chunk_size = result_data.message.length();
+		result_data.num_of_chunks = 1;
+	}
+}
+
+
+unsigned long ResultStore::add(resultData &result_data, const int &output_size)
+// Stores Result String and returns Unique ID, used by SYNC Calls where message > outputsize
+{
+	const unsigned long unique_id = unique_id_counter++;
+	save(unique_id, result_data, output_size);
+	return unique_id;
+}
+
+
+void ResultStore::save(const unsigned long &unique_id, resultData &result_data, const int &output_size)
+// Stores Result String for Unique ID
+//   Streamed Result, appends the remaining data + closes the stream
+{
+	split(result_data, output_size);
+	shard_struct &shard = getShard(unique_id);
+	std::unique_lock<std::mutex> lock(shard.mutex);
+	resultData &stored_result = shard.results[unique_id];
+	if (stored_result.streaming)
+	{
+		stored_result.message += result_data.message;
+		stored_result.streaming = false;
+		lock.unlock();
+		recycle(result_data.message);
+	}	else {
+		stored_result = std::move(result_data);
+		stored_result.wait = false;
+	}
+}
+
+
+void ResultStore::save(std::vector<unsigned long> &unique_ids, const resultData &result_data)
+// Stores Result for multiple Unique IDs (used by Rcon Backend)
+{
+	for (auto &unique_id : unique_ids)
+	{
+		shard_struct &shard = getShard(unique_id);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		resultData &stored_result = shard.results[unique_id];
+		stored_result = result_data;
+		stored_result.wait = false;
+	}
+}
+
+
+int ResultStore::streamSize(const unsigned long &unique_id)
+// Part size the worker should stream with, 0 == result can't be streamed i.e SYNC or Batch Call
+{
+	shard_struct &shard = getShard(unique_id);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto itr = shard.results.find(unique_id);
+	if ((itr == shard.results.end()) || (!itr->second.wait && !itr->second.streaming))
+	{
+		return 0;
+	}
+	return itr->second.stream_size;
+}
+
+
+bool ResultStore::stream(const unsigned long &unique_id, std::string &data)
+// Appends data to a streamed result + clears data, SQF can fetch parts via 5: as soon as they are complete
+//   Already sent parts are dropped once they are half of the message, so memory stays around the unsent data
+{
+	shard_struct &shard = getShard(unique_id);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto itr = shard.results.find(unique_id);
+	if ((itr == shard.results.end()) || (itr->second.stream_size <= 0) || (!itr->second.wait && !itr->second.streaming))
+	{
+		return false;
+	}
+	resultData &result_data = itr->second;
+	if ((result_data.read_pos > 0) && (result_data.read_pos >= (result_data.message.length() / 2)))
+	{
+		result_data.message.erase(0, result_data.read_pos);
+		result_data.read_pos = 0;
+	}
+	result_data.message += data;
+	result_data.chunk_size = result_data.stream_size;
+	result_data.wait = false;
+	result_data.streamed = true;
+	result_data.streaming = true;
+	data.clear();
+	return true;
+}
+
+
+void ResultStore::getSinglePart(char *output, const int &output_size, const unsigned long &unique_id, const bool report_chunks)
+// Gets Result String from unordered map array -- Result Formt == Single-Message
+//   If <=, then sends output to arma, and removes entry from unordered map array
+//   If >, sends [5] to indicate MultiPartResult, or [5,<number of parts>] if report_chunks
+{
+	std::string recycled_buffer;
+	shard_struct &shard = getShard(unique_id);
+	std::unique_lock<std::mutex> lock(shard.mutex);
+
+	auto const_itr = shard.results.find(unique_id);
+	if (const_itr == shard.results.end()) // NO UNIQUE ID
+	{
+		std::strcpy(output, "");
+	}
+	else // SEND MSG (Part)
+	{
+		if (const_itr->second.wait) // WAIT
+		{
+			std::strcpy(output, "[3]");
+		}
+		else if (const_itr->second.streamed) // Streamed, number of parts isn't known
+		{
+			std::strcpy(output, "[5]");
+		}
+		else if (const_itr->second.message.length() > static_cast<std::string::size_type>(output_size))
+		{
+			if (report_chunks)
+			{
+				std::strcpy(output, ("[5," + std::to_string(const_itr->second.num_of_chunks) + "]").c_str());
+			} else {
+				std::strcpy(output, "[5]");
+			}
+		}
+		else
+		{
+			std::memcpy(output, const_itr->second.message.c_str(), const_itr->second.message.length() + 1);
+			recycled_buffer = std::move(const_itr->second.message);
+			shard.results.erase(const_itr);
+			lock.unlock();
+			recycle(recycled_buffer);
+		}
+	}
+}
+
+
+void ResultStore::getMultiPart(char *output, const int &output_size, const unsigned long &unique_id)
+// Gets Result String from unordered map array  -- Result Format = Multi-Message
+//   Copies next part to arma + advances read cursor, message itself is never copied
+//   Entry is removed once the last part is sent, so a following call gets "" (end of message) as before
+//   Streamed Result, [3] until the next full part has arrived, entry is only removed once the stream is closed
+{
+	std::string recycled_buffer;
+	shard_struct &shard = getShard(unique_id);
+	std::unique_lock<std::mutex> lock(shard.mutex);
+
+	auto const_itr = shard.results.find(unique_id);
+	if (const_itr == shard.results.end()) // NO UNIQUE ID or END of MSG
+	{
+		std::strcpy(output, "");
+	}
+	else if (const_itr->second.wait)
+	{
+		std::strcpy(output, "[3]");
+	}
+	else // SEND MSG (Part)
+	{
+		resultData &result_data = const_itr->second;
+		std::string::size_type part_size = result_data.chunk_size;
+		if ((part_size == 0) || (part_size > static_cast<std::string::size_type>(output_size)))
+		{
+			part_size = output_size;
+		}
+		if (result_data.streaming && ((result_data.message.length() - result_data.read_pos) < part_size))
+		{
+			// Still Streaming, only full parts are sent
+			std::strcpy(output, "[3]");
+			return;
+		}
+		part_size = std::min(part_size, (result_data.message.length() - result_data.read_pos));
+		std::memcpy(output, (result_data.message.data() + result_data.read_pos), part_size);
+		output[part_size] = '\0';
+		result_data.read_pos += part_size;
+		if ((!result_data.streaming) && (result_data.read_pos >= result_data.message.length()))
+		{
+			recycled_buffer = std::move(result_data.message);
+			shard.results.erase(const_itr);
+			lock.unlock();
+			recycle(recycled_buffer);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer_pool.h"
+
+
+class ResultStore
+// Results are sharded by Unique ID modulo number of shards, each shard has its own lock
+//   Unique ID generator is atomic, so callExtension never waits on a worker saving a result
+{
+public:
+	struct resultData
+	{
+		bool wait = true;
+		std::string message;
+		std::string::size_type read_pos = 0; // Multi-Part Read Cursor
+
+		// Split by Worker Thread when result is saved
+		std::string::size_type chunk_size = 0;
+		unsigned long num_of_chunks = 1;
+
+		// Streamed Result, parts are sent while the worker is still appending
+		int stream_size = 0; // > 0 == worker is allowed to stream
+		bool streamed = false;
+		bool streaming = false;
+	};
+
+	ResultStore(std::size_t num_of_shards = 16, BufferPool *buffer_pool = nullptr);
+	~ResultStore();
+
+	unsigned long reserve(const int stream_size = 0);
+	unsigned long add(resultData &result_data, const int &output_size);
+	void save(const unsigned long &unique_id, resultData &result_data, const int &output_size);
+	void save(std::vector<unsigned long> &unique_ids, const resultData &result_data);
+
+	int streamSize(const unsigned long &unique_id);
+	bool stream(const unsigned long &unique_id, std::string &data);
+
+	void getSinglePart(char *output, const int &output_size, const unsigned long &unique_id, const bool report_chunks=false);
+	void getMultiPart(char *output, const int &output_size, const unsigned long &unique_id);
+
+private:
+	struct shard_struct
+	{
+		std::mutex mutex;
+		std::unordered_map<unsigned long, resultData> results;
+	};
+
+	std::size_t num_of_shards;
+	std::unique_ptr<shard_struct[]> shards;
+
+	std::atomic<unsigned long> unique_id_counter;
+
+	BufferPool *buffer_pool_ptr;
+
+	shard_struct& getShard(const unsigned long &unique_id);
+	void split(resultData &result_data, const int &output_size);
+	void recycle(std::string &buffer);
+};
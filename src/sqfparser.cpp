@@ -197,6 +197,7 @@ inline bool sqf_skip_special(std::string &input_str, std::string::size_type &pos
 
 inline bool sqf_skip_array(std::string &input_str, std::string::size_type &pos)
 {
+	pos++; // Skip [
 	bool loop = true;
 	bool status = true;
 
@@ -220,7 +221,7 @@ inline bool sqf_skip_array(std::string &input_str, std::string::size_type &pos)
 				loop = false;
 				break;
 			case '[':
-				sqf_skip_array(input_str, pos);
+				status = sqf_skip_array(input_str, pos);
 				break;
 			case '-':
 			case '0':
@@ -254,7 +255,19 @@ inline bool sqf_skip_array(std::string &input_str, std::string::size_type &pos)
 }
 
 
-inline bool sqf_extract_array(std::string &input_str, std::vector<std::string> &output_vec)
+inline bool sqf_extract_nested_array(std::string &input_str, std::string::size_type &pos, std::vector<std::string> &output_vec)
+{
+	const std::string::size_type start_pos = pos;
+	if (sqf_skip_array(input_str, pos))
+	{
+		output_vec.push_back(input_str.substr(start_pos, (pos - start_pos + 1)));
+		return true;
+	}
+	return false;
+}
+
+
+inline bool sqf_extract_array(std::string &input_str, std::vector<std::string> &output_vec, const bool extract_arrays)
 {
 	std::string::size_type pos = 1;
 	bool loop = true;
@@ -280,7 +293,12 @@ inline bool sqf_extract_array(std::string &input_str, std::vector<std::string> &
 			loop = false;
 			break;
 		case '[':
-			sqf_skip_array(input_str, pos);
+			if (extract_arrays)
+			{
+				status = sqf_extract_nested_array(input_str, pos, output_vec);
+			}	else {
+				status = sqf_skip_array(input_str, pos);
+			}
 			break;
 		case '-':
 		case '0':
@@ -316,14 +334,14 @@ inline bool sqf_extract_array(std::string &input_str, std::vector<std::string> &
 
 namespace sqf
 {
-	bool parser(std::string &input_str, std::vector<std::string> &output_vec)
+	bool parser(std::string &input_str, std::vector<std::string> &output_vec, const bool extract_arrays)
 	{
 		bool status = false;
 		if (!(input_str.empty()))
 		{
 			if ((input_str.front() == '[') && (input_str.back() == ']'))
 			{
-				status = sqf_extract_array(input_str, output_vec);
+				status = sqf_extract_array(input_str, output_vec, extract_arrays);
 			}
 		}
 		return status;
@@ -11,5 +11,7 @@
 
 namespace sqf
 {
-	bool parser(std::string &input_str, std::vector<std::string> &output_vec);
+	// extract_arrays == false, nested arrays are skipped
+	// extract_arrays == true, nested arrays are returned as their raw sqf text i.e [["a",1],["b",2]] -> "[\"a\",1]", "[\"b\",2]"
+	bool parser(std::string &input_str, std::vector<std::string> &output_vec, const bool extract_arrays=false);
 }
@@ -3,13 +3,246 @@
  * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
  */
 
+#include <atomic>
+#include <chrono>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "ext.h"
+#include "result_store.h"
+#include "mariaDB/connector.h"
+#include "mariaDB/datetime.h"
+#include "mariaDB/query.h"
+#include "mariaDB/session.h"
+#include "mariaDB/statement.h"
 
 #ifdef TEST_APP
+	extern std::atomic<unsigned long long> test_app_allocations; // memory_allocator.cpp
+
+	void benchResultStore(Ext *extension)
+	// Save + Poll throughput of ResultStore, 1 Shard == old single mutex_results behaviour
+	{
+		const int iterations = 100000;
+		for (std::size_t num_of_shards : {1, 16})
+		{
+			for (int num_of_threads = 1; num_of_threads <= 16; num_of_threads *= 2)
+			{
+				ResultStore store(num_of_shards);
+				auto start = std::chrono::steady_clock::now();
+
+				std::vector<std::thread> threads;
+				for (int i = 0; i < num_of_threads; ++i)
+				{
+					threads.emplace_back([&store, iterations]()
+					{
+						char output[81] = {0};
+						ResultStore::resultData result_data;
+						for (int j = 0; j < iterations; ++j)
+						{
+							const unsigned long unique_id = store.reserve();
+							store.getSinglePart(output, 80, unique_id); // [3]
+							result_data.message = "[1,[[1,\"testing\"]]]";
+							store.save(unique_id, result_data, 80);
+							store.getSinglePart(output, 80, unique_id);
+						}
+					});
+				}
+				for (auto &thread : threads)
+				{
+					thread.join();
+				}
+
+				auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+				if (elapsed == 0) elapsed = 1;
+				long long ops = (static_cast<long long>(num_of_threads) * iterations * 4 * 1000000) / elapsed;
+				extension->console->info("extDB3: Bench Results: Shards: {0} Threads: {1} Time: {2}ms Ops/s: {3}", num_of_shards, num_of_threads, (elapsed / 1000), ops);
+			}
+		}
+	}
+
+
+	void benchStatement(Ext *extension, const std::string &database_id)
+	// Time + Allocations per execute of a cached prepared statement
+	//   Requires 9:ADD_DATABASE:<Database Config>:<database_id> first, empty result == binding overhead only
+	{
+		if (extension->mariadb_databases.count(database_id) == 0)
+		{
+			extension->console->warn("extDB3: Bench Statement: No Database Connection: {0}", database_id);
+			return;
+		}
+		const int iterations = 10000;
+		try
+		{
+			MariaDBSession session(&extension->mariadb_databases[database_id]);
+			for (std::string sql : {"SELECT 1 FROM DUAL WHERE 1 = 0", "SELECT 1, 'testing', NOW()"})
+			{
+				MariaDBStatement statement;
+				statement.init(session.data->connector);
+				statement.create();
+				statement.prepare(sql);
+
+				std::vector<MariaDBStatement::mysql_bind_param> params;
+				std::vector<MariaDBTransform> output_transforms;
+				int strip_chars_mode = 0;
+				std::string insertID;
+				std::string result;
+				MariaDBSQFRowSink sink(result);
+				statement.bindParams(params);
+				statement.execute(output_transforms, strip_chars_mode, insertID, sink); // Warmup
+
+				const unsigned long long allocations_start = test_app_allocations.load();
+				auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < iterations; ++i)
+				{
+					sink.clear();
+					statement.execute(output_transforms, strip_chars_mode, insertID, sink);
+				}
+				auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+				const unsigned long long allocations = test_app_allocations.load() - allocations_start;
+				extension->console->info("extDB3: Bench Statement: {0}: Executes: {1} Time: {2}ms Allocations: {3} Allocations/Execute: {4}", sql, iterations, (elapsed / 1000), allocations, (static_cast<double>(allocations) / iterations));
+			}
+		}
+		catch (std::exception &e)
+		{
+			extension->console->error("extDB3: Bench Statement: Error: {0}", e.what());
+		}
+	}
+
+
+	void benchConnection(Ext *extension, const std::string &database_id)
+	// Round trips + large result throughput per connection option, same login as the database_id pool
+	//   TLS + Socket variants are skipped if the connection fails i.e server without TLS / no Socket configured
+	{
+		if (extension->mariadb_databases.count(database_id) == 0)
+		{
+			extension->console->warn("extDB3: Bench Connection: No Database Connection: {0}", database_id);
+			return;
+		}
+		MariaDBPool &database_pool = extension->mariadb_databases[database_id];
+
+		std::vector<std::pair<std::string, MariaDBConnector::options_struct>> variants;
+		MariaDBConnector::options_struct options = database_pool.connectorOptions();
+		options.compress = false;
+		options.tls = false;
+		options.socket.clear();
+		variants.push_back(std::make_pair("TCP", options));
+		options.compress = true;
+		variants.push_back(std::make_pair("TCP + Compress", options));
+		options.compress = false;
+		options.tls = true;
+		variants.push_back(std::make_pair("TLS", options));
+		options.compress = true;
+		variants.push_back(std::make_pair("TLS + Compress", options));
+		if (!database_pool.connectorOptions().socket.empty())
+		{
+			options.compress = false;
+			options.tls = false;
+			options.socket = database_pool.connectorOptions().socket;
+			variants.push_back(std::make_pair("Socket", options));
+		}
+
+		const int small_iterations = 2000;
+		const int large_iterations = 200;
+		const int large_size = 65536; // Compressible, similar to loadout / JSON blobs
+		for (auto &variant : variants)
+		{
+			try
+			{
+				MariaDBConnector connector;
+				database_pool.initConnector(connector, variant.second);
+				auto start = std::chrono::steady_clock::now();
+				connector.connect();
+				auto connect_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+				MariaDBQuery query;
+				query.init(connector);
+				std::vector<MariaDBTransform> output_transforms;
+				std::string insertID;
+				std::string result;
+				MariaDBSQFRowSink sink(result);
+
+				std::string small_sql("SELECT 1");
+				start = std::chrono::steady_clock::now();
+				for (int i = 0; i < small_iterations; ++i)
+				{
+					sink.clear();
+					query.send(small_sql);
+					query.get(output_transforms, 0, insertID, sink);
+				}
+				auto small_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+				std::string large_sql("SELECT REPEAT('extDB3 ', " + std::to_string(large_size / 7) + ")");
+				start = std::chrono::steady_clock::now();
+				for (int i = 0; i < large_iterations; ++i)
+				{
+					sink.clear();
+					query.send(large_sql);
+					query.get(output_transforms, 0, insertID, sink);
+				}
+				auto large_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+				if (small_elapsed == 0) small_elapsed = 1;
+				if (large_elapsed == 0) large_elapsed = 1;
+
+				extension->console->info("extDB3: Bench Connection: {0}: Connect: {1}ms Round Trips/s: {2} Large Results/s: {3} MB/s: {4}", variant.first, (connect_elapsed / 1000),
+					((small_iterations * 1000000LL) / small_elapsed), ((large_iterations * 1000000LL) / large_elapsed),
+					((static_cast<double>(large_size) * large_iterations) / large_elapsed));
+			}
+			catch (std::exception &e)
+			{
+				extension->console->warn("extDB3: Bench Connection: {0}: Skipped: {1}", variant.first, e.what());
+			}
+		}
+	}
+
+
+	void benchDateTime(Ext *extension)
+	// DATETIME cell -> SQF Time Array, istringstream + time_facet (previous MariaDBQuery::get) vs MariaDBDateTime::convert
+	{
+		const int iterations = 1000000;
+		const std::string value("2017-01-31 23:59:00");
+		const std::locale loc_datetime(std::locale::classic(), new boost::posix_time::time_input_facet("%Y-%m-%d %H:%M:%S"));
+		std::string output;
+		output.reserve(64);
+
+		const unsigned long long allocations_start = test_app_allocations.load();
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			output.clear();
+			std::istringstream is(value);
+			is.imbue(loc_datetime);
+			boost::posix_time::ptime ptime;
+			is >> ptime;
+
+			std::stringstream stream;
+			boost::posix_time::time_facet *facet = new boost::posix_time::time_facet();
+			facet->format("[%Y,%m,%d,%H,%M,%S]");
+			stream.imbue(std::locale(std::locale::classic(), facet));
+			stream << ptime;
+			output += stream.str();
+		}
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		unsigned long long allocations = test_app_allocations.load() - allocations_start;
+		extension->console->info("extDB3: Bench DateTime: Stream + Facet: {0} Cells: {1} Time: {2}ms Allocations: {3}", output, iterations, (elapsed / 1000), allocations);
+
+		const unsigned long long allocations_start2 = test_app_allocations.load();
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; ++i)
+		{
+			output.clear();
+			MariaDBDateTime::convert(value.data(), value.size(), MariaDBDateTime::DATETIME, output);
+		}
+		elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		allocations = test_app_allocations.load() - allocations_start2;
+		extension->console->info("extDB3: Bench DateTime: MariaDBDateTime: {0} Cells: {1} Time: {2}ms Allocations: {3}", output, iterations, (elapsed / 1000), allocations);
+	}
+
+
 	int main(int nNumberofArgs, char* pszArgs[])
 	{
 		int result_size = 80;
@@ -33,6 +266,24 @@
 			{
 				test = true;
 			}
+			else if (boost::algorithm::iequals(input_str, "Bench Results") == 1)
+			{
+				benchResultStore(extension);
+			}
+			else if (boost::algorithm::iequals(input_str, "Bench DateTime") == 1)
+			{
+				benchDateTime(extension);
+			}
+			else if (boost::algorithm::istarts_with(input_str, "Bench Connection "))
+			{
+				// Bench Connection <database_id>
+				benchConnection(extension, input_str.substr(17));
+			}
+			else if (boost::algorithm::istarts_with(input_str, "Bench Statement "))
+			{
+				// Bench Statement <database_id>
+				benchStatement(extension, input_str.substr(16));
+			}
 			else
 			{
 				extension->callExtension(result, result_size, input_str.c_str());
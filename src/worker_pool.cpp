@@ -0,0 +1,313 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#include "worker_pool.h"
+
+#include <algorithm>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+
+
+namespace
+{
+	thread_local bool worker_retired = false;
+}
+
+
+WorkerPool::WorkerPool(boost::asio::io_service &io_service) : io_service_ptr(&io_service), grow_wait(100), idle_timeout(60), starvation_wait(500),
+	num_of_threads(0), busy_threads(0), queued_jobs(0), completed_jobs(0), max_wait_ms(0), last_saturated(0)
+{
+}
+
+
+WorkerPool::~WorkerPool(void)
+{
+}
+
+
+bool WorkerPool::getPriorityClass(const std::string &name, priority_class &priority)
+{
+	if (boost::algorithm::iequals(name, std::string("HIGH")))
+	{
+		priority = HIGH;
+	}
+	else if (boost::algorithm::iequals(name, std::string("NORMAL")))
+	{
+		priority = NORMAL;
+	}
+	else if (boost::algorithm::iequals(name, std::string("LOW")))
+	{
+		priority = LOW;
+	}	else {
+		return false;
+	}
+	return true;
+}
+
+
+void WorkerPool::start(int min_threads, int max_threads, int grow_wait_ms, int idle_timeout_secs, int starvation_wait_ms)
+{
+	this->min_threads = std::max(min_threads, 1);
+	this->max_threads = std::max(max_threads, this->min_threads);
+	grow_wait = std::chrono::milliseconds(std::max(grow_wait_ms, 0));
+	idle_timeout = std::chrono::seconds(std::max(idle_timeout_secs, 1));
+	starvation_wait = std::chrono::milliseconds(std::max(starvation_wait_ms, 0));
+	last_saturated = std::chrono::steady_clock::now().time_since_epoch().count();
+
+	io_work_ptr.reset(new boost::asio::io_service::work(*io_service_ptr));
+	{
+		std::lock_guard<std::mutex> lock(mutex_threads);
+		stopping = false;
+		for (int i = 0; i < this->min_threads; ++i)
+		{
+			addThread();
+		}
+	}
+
+	if (this->max_threads > this->min_threads)
+	{
+		std::lock_guard<std::mutex> lock(mutex_maintenance_timer);
+		maintenance_timer.reset(new boost::asio::deadline_timer(*io_service_ptr));
+		maintenance_timer->expires_from_now(boost::posix_time::seconds(5));
+		maintenance_timer->async_wait(boost::bind(&WorkerPool::maintenance, this, _1));
+	}
+}
+
+
+void WorkerPool::stop()
+// Waits for all queued work to finish
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_maintenance_timer);
+		if (maintenance_timer)
+		{
+			maintenance_timer->cancel();
+			maintenance_timer.reset(nullptr);
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_threads);
+		stopping = true;
+	}
+	io_work_ptr.reset(nullptr);
+
+	// Threads can't be joined while holding mutex_threads, running work might be trying to grow the pool
+	while (true)
+	{
+		std::list<std::unique_ptr<boost::thread>> joining;
+		{
+			std::lock_guard<std::mutex> lock(mutex_threads);
+			joining.swap(threads);
+		}
+		if (joining.empty()) break;
+		for (auto &thread : joining)
+		{
+			thread->join();
+		}
+	}
+	std::lock_guard<std::mutex> lock(mutex_threads);
+	retired_threads.clear();
+	num_of_threads = 0;
+}
+
+
+void WorkerPool::post(std::function<void()> handler, const priority_class priority)
+// Saturation is checked here as well, when every worker is blocked in a call nothing gets dequeued to notice it
+{
+	auto tick = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point oldest = tick;
+	{
+		std::lock_guard<std::mutex> lock(mutex_jobs);
+		jobs[priority].push_back(job_struct{tick, std::move(handler)});
+		for (int i = 0; i < num_of_priority_classes; ++i)
+		{
+			if ((!jobs[i].empty()) && (jobs[i].front().queued < oldest))
+			{
+				oldest = jobs[i].front().queued;
+			}
+		}
+	}
+	++queued_jobs;
+	io_service_ptr->post(boost::bind(&WorkerPool::runNext, this));
+
+	if ((busy_threads >= num_of_threads) && ((tick - oldest) > grow_wait))
+	{
+		last_saturated = tick.time_since_epoch().count();
+		grow();
+	}
+}
+
+
+void WorkerPool::addThread()
+// Requires mutex_threads
+{
+	threads.emplace_back(new boost::thread(boost::bind(&WorkerPool::worker, this)));
+	++num_of_threads;
+}
+
+
+void WorkerPool::grow()
+// Enough threads for the queued backlog less any idle threads, within max_threads
+{
+	std::lock_guard<std::mutex> lock(mutex_threads);
+	long long needed = static_cast<long long>(queued_jobs.load()) - (num_of_threads - busy_threads);
+	while ((!stopping) && (needed > 0) && (num_of_threads < max_threads))
+	{
+		addThread();
+		--needed;
+	}
+}
+
+
+void WorkerPool::retire()
+// Runs on the worker thread that is leaving the pool
+{
+	worker_retired = true;
+}
+
+
+void WorkerPool::worker()
+{
+	worker_retired = false;
+	while (!worker_retired)
+	{
+		if (io_service_ptr->run_one() == 0) break; // Stopped + No More Work
+	}
+	if (worker_retired)
+	{
+		std::lock_guard<std::mutex> lock(mutex_threads);
+		retired_threads.push_back(boost::this_thread::get_id());
+	}
+}
+
+
+void WorkerPool::runNext()
+// One runNext is posted per job, so whichever job is picked here every job still gets run
+//   Highest priority class first, unless a lower class has waited past starvation_wait + is older
+{
+	job_struct job;
+	auto tick = std::chrono::steady_clock::now();
+	std::chrono::milliseconds wait;
+	{
+		std::lock_guard<std::mutex> lock(mutex_jobs);
+		int selected = -1;
+		bool aged = false;
+		for (int i = 0; i < num_of_priority_classes; ++i)
+		{
+			if (jobs[i].empty()) continue;
+			if (selected == -1)
+			{
+				selected = i;
+			}
+			else if (((tick - jobs[i].front().queued) > starvation_wait) && (jobs[i].front().queued < jobs[selected].front().queued))
+			{
+				selected = i;
+				aged = true;
+			}
+		}
+		if (selected == -1) return;
+		job = std::move(jobs[selected].front());
+		jobs[selected].pop_front();
+
+		wait = std::chrono::duration_cast<std::chrono::milliseconds>(tick - job.queued);
+		queue_stats_struct &stats = queue_stats[selected];
+		++stats.dispatched;
+		if (aged) ++stats.aged;
+		stats.total_wait_ms += wait.count();
+		if (wait.count() > stats.max_wait_ms)
+		{
+			stats.max_wait_ms = wait.count();
+		}
+	}
+	--queued_jobs;
+
+	if (wait.count() > max_wait_ms)
+	{
+		max_wait_ms = wait.count();
+	}
+
+	int busy = ++busy_threads;
+	if (wait > grow_wait)
+	{
+		last_saturated = tick.time_since_epoch().count();
+		grow();
+	}
+	else if (busy >= num_of_threads)
+	{
+		last_saturated = tick.time_since_epoch().count();
+	}
+
+	job.handler();
+
+	--busy_threads;
+	++completed_jobs;
+}
+
+
+void WorkerPool::maintenance(const boost::system::error_code& ec)
+// Joins retired threads + retires one thread per tick while pool is idle
+{
+	if (!ec)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_threads);
+			for (auto &thread_id : retired_threads)
+			{
+				auto thread_itr = std::find_if(threads.begin(), threads.end(), [&thread_id](const std::unique_ptr<boost::thread> &thread) { return thread->get_id() == thread_id; });
+				if (thread_itr != threads.end())
+				{
+					(*thread_itr)->join();
+					threads.erase(thread_itr);
+				}
+			}
+			retired_threads.clear();
+
+			auto tick = std::chrono::steady_clock::now();
+			auto idle = tick - std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(last_saturated.load()));
+			if ((!stopping) && (num_of_threads > min_threads) && (idle > idle_timeout))
+			{
+				--num_of_threads;
+				io_service_ptr->post(boost::bind(&WorkerPool::retire, this));
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mutex_maintenance_timer);
+		if (maintenance_timer)
+		{
+			maintenance_timer->expires_from_now(boost::posix_time::seconds(5));
+			maintenance_timer->async_wait(boost::bind(&WorkerPool::maintenance, this, _1));
+		}
+	}
+}
+
+
+void WorkerPool::getStats(std::string &result)
+// [1,[threads,busy threads,queued,completed,max wait ms]]
+{
+	result = "[1,[" + std::to_string(num_of_threads.load()) + "," + std::to_string(busy_threads.load()) + "," + std::to_string(queued_jobs.load()) + "," +
+		std::to_string(completed_jobs.load()) + "," + std::to_string(max_wait_ms.load()) + "]]";
+}
+
+
+void WorkerPool::getQueueStats(std::string &result)
+// [1,[[queued,dispatched,avg wait ms,max wait ms,aged],...]] in HIGH, NORMAL, LOW order
+{
+	std::lock_guard<std::mutex> lock(mutex_jobs);
+	result = "[1,[";
+	for (int i = 0; i < num_of_priority_classes; ++i)
+	{
+		const queue_stats_struct &stats = queue_stats[i];
+		long long avg_wait_ms = 0;
+		if (stats.dispatched > 0)
+		{
+			avg_wait_ms = stats.total_wait_ms / static_cast<long long>(stats.dispatched);
+		}
+		if (i > 0) result += ",";
+		result += "[" + std::to_string(jobs[i].size()) + "," + std::to_string(stats.dispatched) + "," + std::to_string(avg_wait_ms) + "," +
+			std::to_string(stats.max_wait_ms) + "," + std::to_string(stats.aged) + "]";
+	}
+	result += "]]";
+}
@@ -0,0 +1,91 @@
+/*
+ * extDB3
+ * © 2016 Declan Ireland <https://bitbucket.org/torndeco/extdb3>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/thread/thread.hpp>
+
+
+class WorkerPool
+// ASIO Worker Threads
+//   Grows upto max_threads when queued work waits longer than grow_wait
+//   Shrinks back to min_threads once no work has had to wait for idle_timeout
+//   Queued work is served by priority class, lower classes are aged past starvation_wait
+{
+public:
+	enum priority_class { HIGH = 0, NORMAL = 1, LOW = 2 };
+	static const int num_of_priority_classes = 3;
+	static bool getPriorityClass(const std::string &name, priority_class &priority);
+
+	WorkerPool(boost::asio::io_service &io_service);
+	~WorkerPool();
+
+	void start(int min_threads, int max_threads, int grow_wait_ms, int idle_timeout_secs, int starvation_wait_ms);
+	void stop();
+	void post(std::function<void()> handler, const priority_class priority=NORMAL);
+	void getStats(std::string &result);
+	void getQueueStats(std::string &result);
+
+private:
+	boost::asio::io_service *io_service_ptr;
+	std::unique_ptr<boost::asio::io_service::work> io_work_ptr;
+
+	std::mutex mutex_maintenance_timer;
+	std::unique_ptr<boost::asio::deadline_timer> maintenance_timer;
+
+	int min_threads = 1;
+	int max_threads = 1;
+	std::chrono::milliseconds grow_wait;
+	std::chrono::seconds idle_timeout;
+	std::chrono::milliseconds starvation_wait;
+
+	// Queued Work, index == priority_class
+	struct job_struct
+	{
+		std::chrono::steady_clock::time_point queued;
+		std::function<void()> handler;
+	};
+	struct queue_stats_struct
+	{
+		unsigned long long dispatched = 0;
+		unsigned long long aged = 0;
+		long long total_wait_ms = 0;
+		long long max_wait_ms = 0;
+	};
+	std::deque<job_struct> jobs[num_of_priority_classes];
+	queue_stats_struct queue_stats[num_of_priority_classes];
+	std::mutex mutex_jobs;
+
+	// Threads
+	std::list<std::unique_ptr<boost::thread>> threads;
+	std::vector<boost::thread::id> retired_threads;
+	std::mutex mutex_threads;
+	bool stopping = false;
+
+	std::atomic<int> num_of_threads;
+	std::atomic<int> busy_threads;
+	std::atomic<unsigned long> queued_jobs;
+	std::atomic<unsigned long long> completed_jobs;
+	std::atomic<long long> max_wait_ms;
+	std::atomic<long long> last_saturated; // steady_clock ticks
+
+	void addThread();
+	void grow();
+	void retire();
+	void worker();
+	void runNext();
+	void maintenance(const boost::system::error_code& ec);
+};